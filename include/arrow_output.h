@@ -0,0 +1,136 @@
+/**
+ * @file arrow_output.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Apache Arrow IPC stream writer for the batch roots
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_batch.h"
+
+
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+
+//------------------------------------------------------------------------------
+// Arrow writer structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Growing bytes buffer for the encoded messages
+ */
+typedef
+struct arrow_buffer
+{
+    uint8_t* data;      ///< Encoded bytes
+    size_t   size;      ///< Number of used bytes
+    size_t   capacity;  ///< Number of allocated bytes
+}
+arrow_buffer;
+
+
+/**
+ * @brief Possible results of the Arrow writer
+ */
+typedef
+enum arrow_output_status
+{
+    ARROW_OUTPUT_SUCCESS     = 0,   ///< Messages are encoded or written
+    ARROW_OUTPUT_BAD_ARGS    = 1,   ///< NULL buffer, batch or stream
+    ARROW_OUTPUT_ALLOC_ERROR = 2,   ///< Allocation error occured
+    ARROW_OUTPUT_IO_ERROR    = 3    ///< Write error occured
+}
+arrow_output_status;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Arrow writer interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Appends the schema message to the buffer
+ *
+ * @param buffer Pointer to the buffer
+ *
+ * @retval Status @see arrow_output_status
+ *
+ * @details The schema has three columns:
+ * x1 (nullable float64), x2 (nullable float64), roots_number (int8)
+ */
+arrow_output_status
+ArrowEncodeSchema (arrow_buffer* buffer);
+
+
+/**
+ * @brief Appends the record batch message with the batch roots
+ *
+ * @param buffer Pointer to the buffer
+ * @param batch  Pointer to the solved batch
+ *
+ * @retval Status @see arrow_output_status
+ *
+ * @details The body is built straight from the batch columns:
+ * NaN roots are marked null in the validity bitmaps and stored as zeros,
+ * roots numbers are narrowed to int8
+ */
+arrow_output_status
+ArrowEncodeRecordBatch (arrow_buffer*                   buffer,
+                        const quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Appends the end of stream marker to the buffer
+ *
+ * @param buffer Pointer to the buffer
+ *
+ * @retval Status @see arrow_output_status
+ */
+arrow_output_status
+ArrowEncodeEndOfStream (arrow_buffer* buffer);
+
+
+/**
+ * @brief Writes the whole Arrow IPC stream with the batch roots
+ *
+ * @param output Output stream
+ * @param batch  Pointer to the solved batch
+ *
+ * @retval Status @see arrow_output_status
+ *
+ * @details Writes the schema, record batches of at most
+ * 65536 rows each and the end of stream marker
+ */
+arrow_output_status
+ArrowWriteBatch (FILE*                           output,
+                 const quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Frees the buffer memory
+ *
+ * @param buffer Pointer to the buffer
+ *
+ * @details The buffer is left empty and may be reused
+ */
+void
+ArrowBufferDestructor (arrow_buffer* buffer);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,161 @@
+/**
+ * @file csv_ingest.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Delimited (CSV/TSV) files solver
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "arrow_output.h"
+#include "quadratic_equation_batch.h"
+
+
+
+#include <stdio.h>
+
+
+
+//------------------------------------------------------------------------------
+// Delimited files solver structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Options of the delimited files solver
+ *
+ * @details Column selector is either a column name from the header row
+ * or its 1-based index written in decimal digits
+ *
+ * @see CsvIngestOptionsInit() for default values
+ */
+typedef
+struct csv_ingest_options
+{
+    char        delimiter;              ///< Fields delimiter, ',' or '\t' usually
+    bool        has_header;             ///< The first line is a header row
+    const char* a_column;               ///< Selector of the coefficient before \f$ x^2 \f$
+    const char* b_column;               ///< Selector of the coefficient before \f$ x \f$
+    const char* c_column;               ///< Selector of the free coefficient
+    const char* key_column;             ///< Selector of the passthrough column, NULL if none
+    size_t      threads;                ///< Number of parsing threads, 0 for all CPUs
+    bool        arrow_output;           ///< Write Arrow IPC stream instead of text
+    const char* checkpoint_path;        ///< Checkpoint file, NULL for no checkpoints
+    size_t      checkpoint_interval;    ///< Input bytes between checkpoints
+    bool        resume;                 ///< Continue from the checkpoint if it exists, needs checkpoint_path
+    quadratic_batch_options solve;      ///< Batch solver options
+}
+csv_ingest_options;
+
+
+/**
+ * @brief Possible results of the delimited files solver
+ */
+typedef
+enum csv_ingest_status
+{
+    CSV_INGEST_SUCCESS          = 0,    ///< The whole input is processed
+    CSV_INGEST_BAD_ARGS         = 1,    ///< NULL streams, selectors or bad options
+    CSV_INGEST_BAD_COLUMN       = 2,    ///< Column selector is not found
+    CSV_INGEST_ALLOC_ERROR      = 3,    ///< Allocation error occured
+    CSV_INGEST_IO_ERROR         = 4,    ///< Read or write error occured
+    CSV_INGEST_THREAD_ERROR     = 5,    ///< Thread can not be started
+    CSV_INGEST_CHECKPOINT_ERROR = 6,    ///< Streams are not seekable or bad checkpoint
+    CSV_INGEST_STATUS_COUNT     = 7     ///< Number of statuses
+}
+csv_ingest_status;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Delimited files solver interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes delimited files solver options with default values
+ *
+ * @param options Pointer to the options
+ *
+ * @details Default values: delimiter = ',', has_header = true,
+ * a_column = "a", b_column = "b", c_column = "c", key_column = NULL,
+ * threads = 0, arrow_output = false, checkpoint_path = NULL,
+ * checkpoint_interval = 256 MiB, resume = false,
+ * solve is initialized by BatchOptionsInit()
+ */
+void
+CsvIngestOptionsInit (csv_ingest_options* options);
+
+
+/**
+ * @brief Solves equations from the delimited input
+ *
+ * @param input       Input  stream
+ * @param output      Output stream
+ * @param options     Pointer to the options, NULL for default ones
+ * @param rows_number Pointer to the number of solved rows, may be NULL
+ *
+ * @retval Status @see csv_ingest_status
+ *
+ * @details The input is read by large windows, every window is split
+ * on line boundaries into chunks that are parsed, solved and formatted
+ * by parallel threads, the chunks are written in input order
+ * Only the selected fields are converted, the others are skipped
+ * Every output line is key, roots_number, x1, x2 (key is omitted
+ * without key column), NaN roots are written as empty fields
+ * With arrow_output the output is Arrow IPC stream of x1, x2, roots_number
+ * (one record batch per chunk), key column is not written
+ * Missing or unparsable coefficients are NaN, so the row is not solved
+ *
+ * With checkpoint_path both streams must be seekable files:
+ * every checkpoint_interval input bytes (at a window boundary)
+ * the output is flushed and synced, then the input and output offsets
+ * and the rows number are written to a temporary file renamed over
+ * the checkpoint, so the checkpoint never refers to unwritten output
+ * With resume and an existing checkpoint the header is only parsed,
+ * the output is truncated to the checkpointed offset (dropping the
+ * roots written after it) and the input continues from its offset;
+ * without a checkpoint the output is truncated to its start
+ * The checkpoint is removed when the whole input is processed
+ * Resume without checkpoint_path is rejected with CSV_INGEST_BAD_ARGS
+ *
+ * @note Quoted fields may contain delimiters but not line breaks
+ */
+csv_ingest_status
+CsvSolveStream (FILE*                     input,
+                FILE*                     output,
+                const csv_ingest_options* options,
+                size_t*                   rows_number);
+
+
+/**
+ * @brief Parses a decimal floating point number
+ *
+ * @param begin Pointer to the first character
+ * @param end   Pointer past the last character
+ *
+ * @retval The number
+ * @retval NaN if the field is empty or is not a number
+ *
+ * @details Numbers with up to 15 significant digits and decimal exponent
+ * up to 22 are converted exactly without strtod() (Clinger fast path),
+ * the others fall back to strtod() (fields of any length, long ones
+ * are copied to the heap, NaN if that allocation fails)
+ * Surrounding spaces and quotes are ignored
+ */
+double
+CsvParseNumber (const char* begin,
+                const char* end);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,68 @@
+/**
+ * @file doubles_compare.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Tolerant doubles comparison shared by the solver modules
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include <float.h>
+#include <math.h>
+
+
+
+//------------------------------------------------------------------------------
+// Doubles comparison
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Tolerance for double comparison
+ */
+static const double DOUBLES_CMP_TOLERANCE = DBL_EPSILON;
+
+
+/**
+ * @brief Possible results for doubles comparison
+ */
+typedef
+enum doubles_cmp_status
+{
+    DOUBLES_CMP_LESS      = -1,     ///< first is less than second
+    DOUBLES_CMP_EQUAL     =  0,     ///< first is equal to second
+    DOUBLES_CMP_GREATER   =  1,     ///< first is greater than second
+    DOUBLES_CMP_UNDEFINED =  2      ///< NaN input
+}
+doubles_cmp_status;
+
+
+/**
+ * @brief Compares two doubles
+ *
+ * @param a First  double to compare
+ * @param b Second double to compare
+ *
+ * @retval Status @see doubles_cmp_status
+ */
+static inline doubles_cmp_status
+CompareDoubles (double a,
+                double b)
+{
+    if (isnan (a) || isnan (b)) return DOUBLES_CMP_UNDEFINED;
+
+    if (a < b - DOUBLES_CMP_TOLERANCE) return DOUBLES_CMP_LESS;
+    if (a > b + DOUBLES_CMP_TOLERANCE) return DOUBLES_CMP_GREATER;
+    return DOUBLES_CMP_EQUAL;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
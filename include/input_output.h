@@ -17,6 +17,7 @@
 
 
 #include "quadratic_equation.h"
+#include "quadratic_equation_bench.h"
 
 
 
@@ -55,5 +56,44 @@ ReadCoefs (void);
 void
 PrintRoots (const quadratic_equation* equation);
 
+
+
+/**
+ * @brief Prints the benchmark report
+ *
+ * @param report Pointer to the report
+ *
+ * @details Prints one line per case with the best time,
+ * equations per second and columns bandwidth
+ */
+void
+PrintBenchReport (const quadratic_bench_report* report);
+
+
+/**
+ * @brief Prints one benchmark or statistics result
+ *
+ * @param stream Output stream
+ * @param result Pointer to the result
+ *
+ * @details Prints the time, equations per second, columns bandwidth
+ * (if known) and, if counted, IPC and misses per equation
+ */
+void
+PrintBenchResult (FILE*                         stream,
+                  const quadratic_bench_result* result);
+
+
+/**
+ * @brief Prints the latency benchmark report
+ *
+ * @param report Pointer to the report
+ *
+ * @details Prints one line per case with p50, p99, p99.9 and
+ * maximal solve times in nanoseconds
+ */
+void
+PrintLatencyReport (const quadratic_latency_report* report);
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -0,0 +1,55 @@
+/**
+ * @file monotonic_clock.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Monotonic clock shared by the deadlines, metrics and benchmarks
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include <stdint.h>
+#include <time.h>
+
+
+
+//------------------------------------------------------------------------------
+// Monotonic clock
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Returns CLOCK_MONOTONIC time
+ *
+ * @retval Nanoseconds
+ */
+static inline uint64_t
+MonotonicNanoseconds (void)
+{
+    struct timespec now = {0};
+    clock_gettime (CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+
+/**
+ * @brief Returns CLOCK_MONOTONIC time
+ *
+ * @retval Seconds
+ */
+static inline double
+MonotonicSeconds (void)
+{
+    return (double) MonotonicNanoseconds () * 1e-9;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
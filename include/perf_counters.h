@@ -0,0 +1,120 @@
+/**
+ * @file perf_counters.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Hardware performance counters of the process
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+
+//------------------------------------------------------------------------------
+// Performance counters structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Counted hardware events
+ */
+typedef
+enum perf_counter_event
+{
+    PERF_COUNTER_CYCLES        = 0, ///< CPU cycles
+    PERF_COUNTER_INSTRUCTIONS  = 1, ///< Retired instructions
+    PERF_COUNTER_BRANCH_MISSES = 2, ///< Mispredicted branches
+    PERF_COUNTER_L1D_MISSES    = 3, ///< L1 data cache read misses
+    PERF_COUNTER_LLC_MISSES    = 4, ///< Last level cache misses
+    PERF_COUNTER_COUNT         = 5  ///< Number of events
+}
+perf_counter_event;
+
+
+/**
+ * @brief Open counters of the process and the threads it starts
+ */
+typedef
+struct perf_counters
+{
+    int fds[PERF_COUNTER_COUNT];    ///< Descriptors, -1 if the event is not counted
+}
+perf_counters;
+
+
+/**
+ * @brief Counted values
+ */
+typedef
+struct perf_counters_values
+{
+    uint64_t values  [PERF_COUNTER_COUNT];  ///< Values scaled for multiplexing
+    bool     is_valid[PERF_COUNTER_COUNT];  ///< The event was counted
+}
+perf_counters_values;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Performance counters interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Opens the counters of the calling process
+ *
+ * @param counters Pointer to the counters
+ *
+ * @retval true if at least one event is counted
+ *
+ * @details Counts user space events of the calling thread and
+ * the threads started after PerfCountersStart()
+ * Events that are not supported or not permitted (perf_event_open()
+ * is often forbidden in containers) are silently left out
+ */
+bool
+PerfCountersOpen (perf_counters* counters);
+
+
+/**
+ * @brief Closes the counters
+ *
+ * @param counters Pointer to the counters
+ */
+void
+PerfCountersClose (perf_counters* counters);
+
+
+/**
+ * @brief Resets and starts the counters
+ *
+ * @param counters Pointer to the open counters
+ */
+void
+PerfCountersStart (perf_counters* counters);
+
+
+/**
+ * @brief Stops the counters and reads their values
+ *
+ * @param counters Pointer to the started counters
+ * @param values   Pointer to the values
+ */
+void
+PerfCountersStop (perf_counters*        counters,
+                  perf_counters_values* values);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
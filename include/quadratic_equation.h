@@ -22,6 +22,12 @@
 
 
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
 //------------------------------------------------------------------------------
 // Quadratic equation solver structs and types
 //------------------------------------------------------------------------------
@@ -176,3 +182,9 @@ CoefsDestructor (quadratic_equation_coefs* coefs);
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
+
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file quadratic_equation_async.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Non-blocking batch solves on a worker pool
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_batch.h"
+
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+//------------------------------------------------------------------------------
+// Async solver structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Worker pool, @see AsyncPoolConstructor()
+ */
+typedef
+struct quadratic_async_pool
+quadratic_async_pool;
+
+
+/**
+ * @brief Solve request
+ */
+typedef
+struct quadratic_async_request
+quadratic_async_request;
+
+
+/**
+ * @brief Completion callback
+ *
+ * @param request   Pointer to the completed request
+ * @param user_data User data given to AsyncSubmit()
+ *
+ * @details Called by a worker thread after the request is marked done,
+ * as the last access of the pool to the request, so the callback
+ * may free the request or resume a task that frees it
+ * It must not block; it is the place to resume the waiting task
+ * of an executor (e.g. a coroutine)
+ */
+typedef
+void (*quadratic_async_callback) (quadratic_async_request* request,
+                                  void*                    user_data);
+
+
+/**
+ * @brief Solve request, owned by the caller
+ *
+ * @details Fields are set by AsyncSubmit(), the request memory and
+ * the batch columns must stay valid until the request is done
+ */
+struct quadratic_async_request
+{
+    quadratic_equation_batch* batch;        ///< Batch view to solve in place
+    quadratic_async_callback  callback;     ///< Completion callback, may be NULL
+    void*                     user_data;    ///< Argument of the callback
+    quadratic_batch_status    status;       ///< Result, valid when done
+    bool                      done;         ///< Request is completed
+    quadratic_async_request*  next;         ///< Next request in the queue
+};
+
+
+/**
+ * @brief Options of the worker pool
+ *
+ * @see AsyncOptionsInit() for default values
+ */
+typedef
+struct quadratic_async_options
+{
+    size_t threads;         ///< Number of worker threads, 0 for all CPUs
+    size_t coalesce_rows;   ///< Requests smaller than this are coalesced
+    quadratic_batch_options solve;  ///< Options of every solve
+}
+quadratic_async_options;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Async solver interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes worker pool options with default values
+ *
+ * @param options Pointer to the options
+ *
+ * @details Default values: threads = 0, coalesce_rows = 4096,
+ * solve is initialized by BatchOptionsInit()
+ */
+void
+AsyncOptionsInit (quadratic_async_options* options);
+
+
+/**
+ * @brief Constructor for the worker pool
+ *
+ * @param options Pointer to the options, NULL for default ones
+ *
+ * @retval Pointer to the pool with started workers
+ * @retval NULL if allocation or thread start error occured
+ */
+quadratic_async_pool*
+AsyncPoolConstructor (const quadratic_async_options* options);
+
+
+/**
+ * @brief Destructor for the worker pool
+ *
+ * @param pool Pointer to the pool
+ *
+ * @retval NULL
+ *
+ * @details Completes all submitted requests and joins the workers
+ */
+quadratic_async_pool*
+AsyncPoolDestructor (quadratic_async_pool* pool);
+
+
+/**
+ * @brief Submits the batch to be solved without waiting
+ *
+ * @param pool      Pointer to the pool
+ * @param request   Pointer to the request to fill and enqueue
+ * @param batch     Pointer to the batch, solved in place
+ * @param callback  Completion callback, may be NULL
+ * @param user_data Argument of the callback
+ *
+ * @retval QUADRATIC_BATCH_SUCCESS if the request is enqueued
+ * @retval QUADRATIC_BATCH_BAD_ARGS if some pointer is NULL
+ *
+ * @details The batch is not copied if it has at least
+ * coalesce_rows rows: it is solved in place by one worker
+ * Smaller requests waiting in the queue together are gathered
+ * into one worker buffer of coalesce_rows rows and solved by one call
+ * of SolveQuadraticBatch(), then their roots are scattered back
+ */
+quadratic_batch_status
+AsyncSubmit (quadratic_async_pool*     pool,
+             quadratic_async_request*  request,
+             quadratic_equation_batch* batch,
+             quadratic_async_callback  callback,
+             void*                     user_data);
+
+
+/**
+ * @brief Checks whether the request is done without blocking
+ *
+ * @param pool    Pointer to the pool
+ * @param request Pointer to the submitted request
+ *
+ * @retval true if the request is done, its status is valid
+ */
+bool
+AsyncPoll (quadratic_async_pool*    pool,
+           quadratic_async_request* request);
+
+
+/**
+ * @brief Waits for the request to be done
+ *
+ * @param pool    Pointer to the pool
+ * @param request Pointer to the submitted request
+ *
+ * @retval Status of the request @see quadratic_batch_status
+ */
+quadratic_batch_status
+AsyncWait (quadratic_async_pool*    pool,
+           quadratic_async_request* request);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+#ifdef __cplusplus
+}
+#endif
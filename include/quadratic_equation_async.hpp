@@ -0,0 +1,189 @@
+/**
+ * @file quadratic_equation_async.hpp
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief C++20 coroutine interface of the asynchronous batch solver
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_async.h"
+
+
+
+#include <atomic>
+#include <coroutine>
+#include <new>
+#include <span>
+
+
+
+namespace quadratic
+{
+
+//------------------------------------------------------------------------------
+// Coroutine async solver types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Awaitable solve of one batch view, returned by async_pool::solve()
+ *
+ * @details The solve is submitted when the awaiting coroutine suspends
+ * and the coroutine is resumed by the worker thread that completes it,
+ * co_await yields the quadratic_batch_status of the solve
+ * The awaitable lives in the coroutine frame until it is resumed,
+ * so the request and the batch view need no allocation
+ */
+class solve_awaitable
+{
+    public:
+        solve_awaitable (quadratic_async_pool*     pool,
+                         quadratic_equation_batch  batch,
+                         quadratic_batch_status    status) noexcept
+            : pool_ (pool), batch_ (batch), request_ (), status_ (status) {}
+
+        solve_awaitable (const solve_awaitable&)            = delete;
+        solve_awaitable& operator= (const solve_awaitable&) = delete;
+
+        /// @brief Empty views and bad arguments complete without suspension
+        bool
+        await_ready () const noexcept
+        {
+            return status_ != QUADRATIC_BATCH_SUCCESS || batch_.size == 0;
+        }
+
+        /**
+         * @brief Submits the solve
+         *
+         * @retval false if the solve is already completed,
+         * so the coroutine continues at once
+         */
+        bool
+        await_suspend (std::coroutine_handle<> handle) noexcept
+        {
+            handle_ = handle;
+
+            status_ = AsyncSubmit (pool_, &request_, &batch_, Resume, this);
+            if (status_ != QUADRATIC_BATCH_SUCCESS) return false;
+
+            // The first of the submitter and the callback to arrive
+            // leaves the resumption to the other one
+            return !arrived_.exchange (true, std::memory_order_acq_rel);
+        }
+
+        quadratic_batch_status
+        await_resume () const noexcept
+        {
+            return (status_ != QUADRATIC_BATCH_SUCCESS) ? status_ :
+                                                          request_.status;
+        }
+
+    private:
+        static void
+        Resume (quadratic_async_request* /* request */,
+                void*                    user_data) noexcept
+        {
+            solve_awaitable* self = static_cast<solve_awaitable*> (user_data);
+
+            // The frame may be destroyed by the resumed coroutine,
+            // so the handle is the last access to the awaitable
+            if (self->arrived_.exchange (true, std::memory_order_acq_rel))
+                self->handle_.resume ();
+        }
+
+        quadratic_async_pool*    pool_;
+        quadratic_equation_batch batch_;
+        quadratic_async_request  request_;
+        quadratic_batch_status   status_;
+        std::coroutine_handle<>  handle_  = nullptr;
+        std::atomic<bool>        arrived_ = false;
+};
+
+
+/**
+ * @brief Owner of the worker pool with co_await-able solves
+ *
+ * @details Solves are coalesced by the pool as AsyncSubmit() ones,
+ * the spans are viewed in place, nothing is copied for large requests
+ */
+class async_pool
+{
+    public:
+        /**
+         * @brief Starts the worker pool
+         *
+         * @param options Pointer to the options, NULL for default ones
+         *
+         * @throw std::bad_alloc if the pool can not be started
+         */
+        explicit
+        async_pool (const quadratic_async_options* options = nullptr)
+            : pool_ (AsyncPoolConstructor (options))
+        {
+            if (pool_ == nullptr) throw std::bad_alloc ();
+        }
+
+        /// @brief Solves every submitted request and stops the workers
+        ~async_pool ()
+        {
+            pool_ = AsyncPoolDestructor (pool_);
+        }
+
+        async_pool (const async_pool&)            = delete;
+        async_pool& operator= (const async_pool&) = delete;
+
+        /**
+         * @brief Solves the equations given by the coefficients spans
+         *
+         * @retval Awaitable yielding QUADRATIC_BATCH_BAD_ARGS if the spans
+         * sizes differ, the status of the solve otherwise
+         *
+         * @details The spans must stay valid until the solve is resumed
+         */
+        solve_awaitable
+        solve (std::span<const double>                    a,
+               std::span<const double>                    b,
+               std::span<const double>                    c,
+               std::span<double>                          x1,
+               std::span<double>                          x2,
+               std::span<quadratic_equation_roots_number> roots_number)
+            noexcept
+        {
+            const size_t size = a.size ();
+
+            quadratic_equation_batch batch = {};
+            batch.size         = size;
+            // Coefficient columns are only read by the solver
+            batch.a            = const_cast<double*> (a.data ());
+            batch.b            = const_cast<double*> (b.data ());
+            batch.c            = const_cast<double*> (c.data ());
+            batch.x1           = x1.data ();
+            batch.x2           = x2.data ();
+            batch.roots_number = roots_number.data ();
+
+            const bool is_valid = b.size ()  == size && c.size ()  == size &&
+                                  x1.size () == size && x2.size () == size &&
+                                  roots_number.size () == size;
+
+            return solve_awaitable (pool_, batch,
+                                    is_valid ? QUADRATIC_BATCH_SUCCESS :
+                                               QUADRATIC_BATCH_BAD_ARGS);
+        }
+
+    private:
+        quadratic_async_pool* pool_;
+};
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+}   // namespace quadratic
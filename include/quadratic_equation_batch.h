@@ -0,0 +1,591 @@
+/**
+ * @file quadratic_equation_batch.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Batch (structure of arrays) quadratic equation solver
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation.h"
+
+
+
+#ifdef __cplusplus
+    #include <atomic>
+    using std::atomic_bool;
+#else
+    #include <stdatomic.h>
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+//------------------------------------------------------------------------------
+// Batch solver constants
+//------------------------------------------------------------------------------
+
+/// @brief Rows per word of the dirty bitmap
+#define QUADRATIC_BATCH_DIRTY_WORD_ROWS 64
+
+/// @brief Rows solved between two checks of the cancellation token
+#define QUADRATIC_BATCH_CANCEL_CHUNK_ROWS 16384
+
+/// @brief Number of words of the dirty bitmap for the batch of given size
+#define QUADRATIC_BATCH_DIRTY_WORDS(size) \
+    (((size) + QUADRATIC_BATCH_DIRTY_WORD_ROWS - 1) / QUADRATIC_BATCH_DIRTY_WORD_ROWS)
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Batch solver structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief A batch of quadratic equations stored as structure of arrays
+ *
+ * @details Every column holds size elements, row i is the equation
+ * \f$ a_i x^2 + b_i x + c_i = 0 \f$ with roots x1[i], x2[i]
+ * Roots values follow the rules of SolveQuadraticEquation(),
+ * rows with NaN input get QUADRATIC_EQUATION_NOT_SOLVED
+ */
+typedef
+struct quadratic_equation_batch
+{
+    size_t  size;                                   ///< Number of equations
+    double* a;                                      ///< Coefficients before \f$ x^2 \f$
+    double* b;                                      ///< Coefficients before \f$ x \f$
+    double* c;                                      ///< Free coefficients
+    double* x1;                                     ///< First  roots
+    double* x2;                                     ///< Second roots
+    quadratic_equation_roots_number* roots_number;  ///< Numbers of roots
+    void*   mapping;        ///< Memory mapping of all columns, NULL if none
+    size_t  mapping_size;   ///< Size of the memory mapping
+}
+quadratic_equation_batch;
+
+
+/**
+ * @brief Options of the batch solver
+ *
+ * @see BatchOptionsInit() for default values
+ */
+typedef
+struct quadratic_batch_options
+{
+    bool   polish_roots;        ///< Run the polishing stage on ill-conditioned rows
+    double polish_threshold;    ///< Condition threshold, @see SolveQuadraticBatch()
+    size_t polish_iterations;   ///< Halley iterations per polished root
+    bool   classify_first;      ///< Use classified kernels, @see BatchClassify()
+    bool   route_patterns;      ///< Use specialized kernels for known patterns
+    bool   sort_roots;          ///< Emit two roots in ascending order
+    bool   fast_division;       ///< Use the reciprocal kernel without divisions
+}
+quadratic_batch_options;
+
+
+/**
+ * @brief Possible results of the batch solver
+ */
+typedef
+enum quadratic_batch_status
+{
+    QUADRATIC_BATCH_SUCCESS      = 0,   ///< All rows are processed
+    QUADRATIC_BATCH_BAD_ARGS     = 1,   ///< NULL batch or columns, or bad options
+    QUADRATIC_BATCH_ALLOC_ERROR  = 2,   ///< Allocation error occured
+    QUADRATIC_BATCH_CANCELLED    = 3,   ///< Token is cancelled or deadline passed
+    QUADRATIC_BATCH_STATUS_COUNT = 4    ///< Number of statuses
+}
+quadratic_batch_status;
+
+
+/**
+ * @brief Cooperative cancellation token with optional deadline
+ *
+ * @details One token may be shared by any number of solves and threads,
+ * @see CancelTokenInit()
+ */
+typedef
+struct quadratic_cancel_token
+{
+    atomic_bool is_cancelled;   ///< Set by CancelTokenCancel()
+    double      deadline;       ///< CLOCK_MONOTONIC seconds, 0 for no deadline
+}
+quadratic_cancel_token;
+
+
+/**
+ * @brief Compacted list of the roots found in a range
+ *
+ * @details Root k is roots[k] of the equation in row rows[k],
+ * roots of the same row are in ascending order, rows are in ascending order
+ */
+typedef
+struct quadratic_root_list
+{
+    size_t  capacity;   ///< Maximum number of roots
+    size_t  size;       ///< Number of roots
+    size_t* rows;       ///< Rows of the roots
+    double* roots;      ///< Roots values
+}
+quadratic_root_list;
+
+
+/**
+ * @brief Classes of the batch rows
+ *
+ * @details Each class is solved by its own straight-line kernel
+ */
+typedef
+enum quadratic_batch_class
+{
+    QUADRATIC_CLASS_NO_ROOTS  = 0,  ///< No roots (D < 0 or a == b == 0 != c)
+    QUADRATIC_CLASS_ONE_ROOT  = 1,  ///< Quadratic case with D == 0
+    QUADRATIC_CLASS_TWO_ROOTS = 2,  ///< Quadratic case with D >  0
+    QUADRATIC_CLASS_LINEAR    = 3,  ///< Linear case with b != 0
+    QUADRATIC_CLASS_INF_ROOTS = 4,  ///< a == b == c == 0
+    QUADRATIC_CLASS_INVALID   = 5,  ///< NaN discriminant, not solved
+    QUADRATIC_CLASS_COUNT     = 6   ///< Number of classes
+}
+quadratic_batch_class;
+
+
+/**
+ * @brief Row indices of the batch grouped by class
+ *
+ * @details Indices of class k are
+ * indices[offsets[k]] ... indices[offsets[k + 1] - 1]
+ * in ascending order
+ */
+typedef
+struct quadratic_batch_classes
+{
+    size_t  capacity;                           ///< Maximum number of indices
+    size_t  size;                               ///< Number of indices
+    size_t* indices;                            ///< Row indices
+    size_t  offsets[QUADRATIC_CLASS_COUNT + 1]; ///< Class bounds in indices
+}
+quadratic_batch_classes;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Batch solver interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructor for the quadratic_equation_batch structure
+ *
+ * @param size Number of equations
+ *
+ * @retval Pointer to the structure
+ * @retval NULL if allocation error occured
+ *
+ * @details Allocates the structure and all its columns,
+ * coefficients are zero initialized, roots are not solved
+ */
+quadratic_equation_batch*
+BatchConstructor (size_t size);
+
+
+/**
+ * @brief Destructor for the quadratic_equation_batch structure
+ *
+ * @param batch Pointer to the structure
+ *
+ * @retval NULL
+ *
+ * @details Frees the structure and all its columns
+ * (unmaps them if they are placed in one memory mapping)
+ */
+quadratic_equation_batch*
+BatchDestructor (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Initializes batch solver options with default values
+ *
+ * @param options Pointer to the options
+ *
+ * @details Default values:
+ * polish_roots = false, polish_threshold = 1e-6, polish_iterations = 2,
+ * classify_first = false, route_patterns = false, sort_roots = false,
+ * fast_division = false
+ */
+void
+BatchOptionsInit (quadratic_batch_options* options);
+
+
+/**
+ * @brief Checks that the options select at most one row kernel
+ *
+ * @param options Pointer to the options
+ *
+ * @retval true  if at most one of classify_first, route_patterns
+ * and fast_division is set
+ * @retval false otherwise or if options is NULL
+ */
+bool
+BatchOptionsAreValid (const quadratic_batch_options* options);
+
+
+/**
+ * @brief Solves every equation of the batch
+ *
+ * @param batch   Pointer to the batch
+ * @param options Pointer to the options, NULL for default ones
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Solves each row with the same rules as SolveQuadraticEquation()
+ * If options->polish_roots is set, the rows with two or one root are checked
+ * for ill-conditioning (estimate from D relative to \f$ b^2 \f$):
+ * \f$ |D| < t \cdot b^2 \f$ (nearly equal roots) or
+ * \f$ |4ac| < t \cdot b^2 \f$ (cancellation in \f$ -b \pm \sqrt{D} \f$),
+ * where t is options->polish_threshold
+ * Such rows are gathered into a dense subbatch and their roots are refined
+ * by Halley iterations with FMA residual evaluation
+ * A refined root is kept only if it decreases the residual,
+ * roots number is never changed by polishing
+ *
+ * If options->classify_first is set, the batch is processed by blocks:
+ * each block is classified without branches, its rows are compacted
+ * into per-class lists and every list is solved by a straight-line kernel
+ * The results are the same as without classification
+ *
+ * If options->route_patterns is set, the rows of every block are grouped
+ * by coefficient pattern (see quadratic_equation_special.h) and every group is solved by
+ * its specialized kernel, other rows are solved as usual
+ * The results are the same up to the sign of zero roots
+ *
+ * If options->fast_division is set, the rows are solved without divisions:
+ * \f$ 1 / a \f$ and \f$ 1 / b \f$ are found once per row from a bit level
+ * estimate refined by Newton iterations with FMA, the square root is
+ * taken once (a and b out of \f$ [2^{-1000}, 2^{1000}] \f$ are divided)
+ * Roots numbers are the same, roots differ from SolveQuadraticEquation()
+ * ones by at most 2 ULP
+ *
+ * If options->sort_roots is set, x1 <= x2 for every row with two roots
+ * (the roots are swapped by selects, not branches, after all other stages),
+ * otherwise their order follows the sign of a as in SolveQuadraticEquation()
+ *
+ * @note classify_first, route_patterns and fast_division choose different
+ * kernels for the same rows, so they exclude each other: if more than one
+ * is set, QUADRATIC_BATCH_BAD_ARGS is returned and no row is solved,
+ * @see BatchOptionsAreValid()
+ *
+ * @note If the polishing subbatch can not be allocated,
+ * QUADRATIC_BATCH_ALLOC_ERROR is returned and roots stay unpolished
+ */
+quadratic_batch_status
+SolveQuadraticBatch (quadratic_equation_batch*      batch,
+                     const quadratic_batch_options* options);
+
+
+/**
+ * @brief Constructor for the quadratic_root_list structure
+ *
+ * @param capacity Maximum number of roots, twice the batch size is enough
+ *
+ * @retval Pointer to the empty list
+ * @retval NULL if allocation error occured
+ */
+quadratic_root_list*
+RootListConstructor (size_t capacity);
+
+
+/**
+ * @brief Destructor for the quadratic_root_list structure
+ *
+ * @param list Pointer to the structure
+ *
+ * @retval NULL
+ */
+quadratic_root_list*
+RootListDestructor (quadratic_root_list* list);
+
+
+/**
+ * @brief Solves every equation of the batch and keeps the roots in range
+ *
+ * @param batch       Pointer to the batch, roots columns are not written
+ * @param low         Lower bound of the range
+ * @param high        Upper bound of the range
+ * @param list        Pointer to the list of at least 2 * batch->size capacity,
+ * NULL to count the roots only
+ * @param roots_count Pointer to the number of roots in range, may be NULL
+ *
+ * @retval Status @see quadratic_batch_status
+ * @retval QUADRATIC_BATCH_BAD_ARGS if list capacity is too small
+ *
+ * @details Roots are found as by SolveQuadraticBatch() with default options,
+ * sorted and compared with [low, high] in the same pass;
+ * every root is written to the end of the list and the list grows by one
+ * only if the root is in range, so there are no branches on the roots
+ * NaN roots (absent ones) are never in range
+ */
+quadratic_batch_status
+SolveQuadraticBatchInRange (const quadratic_equation_batch* batch,
+                            double                          low,
+                            double                          high,
+                            quadratic_root_list*            list,
+                            size_t*                         roots_count);
+
+
+/**
+ * @brief Re-solves the changed rows of the solved batch
+ *
+ * @param batch   Pointer to the batch
+ * @param options Pointer to the options, NULL for default ones
+ * @param dirty   Bitmap of the changed rows,
+ * QUADRATIC_BATCH_DIRTY_WORDS(batch->size) words
+ *
+ * @retval Status @see quadratic_batch_status
+ * @retval QUADRATIC_BATCH_BAD_ARGS if the options select several kernels,
+ * @see BatchOptionsAreValid()
+ *
+ * @details Row i is changed if bit i % 64 of dirty[i / 64] is set
+ * Only the changed rows are solved, words without set bits are skipped
+ * at once, and their roots are polished and sorted as by
+ * SolveQuadraticBatch() with the same options
+ * With fast_division the rows are solved without divisions as well,
+ * classify_first and route_patterns only choose kernels for whole blocks,
+ * so the scattered rows are solved by the general kernel
+ * (with route_patterns the sign of zero roots may differ)
+ * The bitmap is cleared, so it may be reused for the next changes
+ */
+quadratic_batch_status
+SolveQuadraticBatchDirty (quadratic_equation_batch*      batch,
+                          const quadratic_batch_options* options,
+                          uint64_t*                      dirty);
+
+
+/**
+ * @brief Marks the row of the batch as changed
+ *
+ * @param dirty Bitmap of the changed rows
+ * @param row   Index of the row
+ */
+void
+BatchMarkDirty (uint64_t* dirty,
+                size_t    row);
+
+
+/**
+ * @brief Finds the residuals of the roots of the solved batch
+ *
+ * @param batch         Pointer to the solved batch
+ * @param threshold     Largest residual of a well solved row
+ * @param residuals     Column of batch->size row residuals, may be NULL
+ * @param flagged       Bitmap of the rows with residual above the threshold,
+ * QUADRATIC_BATCH_DIRTY_WORDS(batch->size) words, may be NULL
+ * @param flagged_count Pointer to the number of flagged rows, may be NULL
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Residual of the root x is relative to the coefficients magnitudes:
+ * \f$ |ax^2 + bx + c| / (|a|x^2 + |b||x| + |c|) \f$,
+ * the numerator is evaluated by Horner scheme with FMA
+ * Residual of the row is the largest one of its roots
+ * (x1 for one root, x1 and x2 for two roots, 0 for rows without roots),
+ * NaN residual (overflowed root) is above any threshold
+ * Both roots of every row are evaluated and selected by the roots number,
+ * so the loop has no branches on the rows
+ * The bitmap has the layout of the dirty bitmap, all its words are written
+ */
+quadratic_batch_status
+VerifyQuadraticBatch (const quadratic_equation_batch* batch,
+                      double                          threshold,
+                      double*                         residuals,
+                      uint64_t*                       flagged,
+                      size_t*                         flagged_count);
+
+
+/**
+ * @brief Solves every equation of the batch and finds the residuals
+ *
+ * @param batch         Pointer to the batch
+ * @param options       Pointer to the options, NULL for default ones
+ * @param threshold     Largest residual of a well solved row
+ * @param residuals     Column of batch->size row residuals, may be NULL
+ * @param flagged       Bitmap of the rows with residual above the threshold,
+ * QUADRATIC_BATCH_DIRTY_WORDS(batch->size) words, may be NULL
+ * @param flagged_count Pointer to the number of flagged rows, may be NULL
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details The batch is solved by SolveQuadraticBatch() in blocks of
+ * whole bitmap words and every block is verified by VerifyQuadraticBatch()
+ * right after its solve, while its columns are still in cache
+ */
+quadratic_batch_status
+SolveQuadraticBatchVerified (quadratic_equation_batch*      batch,
+                             const quadratic_batch_options* options,
+                             double                         threshold,
+                             double*                        residuals,
+                             uint64_t*                      flagged,
+                             size_t*                        flagged_count);
+
+
+/**
+ * @brief Makes a view of the batch rows without copying
+ *
+ * @param batch     Pointer to the batch
+ * @param first_row First row of the view
+ * @param rows      Number of rows of the view
+ * @param slice     Pointer to the view to fill, it is not destroyed
+ */
+void
+BatchSlice (const quadratic_equation_batch* batch,
+            size_t                          first_row,
+            size_t                          rows,
+            quadratic_equation_batch*       slice);
+
+
+/**
+ * @brief Initializes the cancellation token
+ *
+ * @param token   Pointer to the token
+ * @param timeout Seconds from now to the deadline, 0 for no deadline
+ */
+void
+CancelTokenInit (quadratic_cancel_token* token,
+                 double                  timeout);
+
+
+/**
+ * @brief Cancels the solves using the token
+ *
+ * @param token Pointer to the token
+ *
+ * @details May be called from any thread, the solves stop
+ * at their next chunk boundary
+ */
+void
+CancelTokenCancel (quadratic_cancel_token* token);
+
+
+/**
+ * @brief Checks whether the token is cancelled or its deadline passed
+ *
+ * @param token Pointer to the token, NULL is never cancelled
+ *
+ * @retval true if the solves using the token must stop
+ */
+bool
+CancelTokenIsCancelled (quadratic_cancel_token* token);
+
+
+/**
+ * @brief Solves the batch by chunks until the token is cancelled
+ *
+ * @param batch       Pointer to the batch
+ * @param options     Pointer to the options, NULL for default ones
+ * @param token       Pointer to the token, NULL to solve all rows
+ * @param solved_rows Pointer to the number of solved rows, may be NULL
+ *
+ * @retval Status @see quadratic_batch_status
+ * @retval QUADRATIC_BATCH_CANCELLED if some rows are not solved
+ *
+ * @details The batch is solved by SolveQuadraticBatch() in chunks of
+ * QUADRATIC_BATCH_CANCEL_CHUNK_ROWS rows, the token is checked
+ * before every chunk, so the solved rows are always the first
+ * *solved_rows ones and the roots of the others are not written
+ * Returning between chunks lets the caller interleave
+ * latency-sensitive batches with the rest of a large one:
+ * a cancelled batch is continued by solving the rows from *solved_rows
+ */
+quadratic_batch_status
+SolveQuadraticBatchCancellable (quadratic_equation_batch*      batch,
+                                const quadratic_batch_options* options,
+                                quadratic_cancel_token*        token,
+                                size_t*                        solved_rows);
+
+
+/**
+ * @brief Constructor for the quadratic_batch_classes structure
+ *
+ * @param size Number of rows to classify
+ *
+ * @retval Pointer to the structure
+ * @retval NULL if allocation error occured
+ */
+quadratic_batch_classes*
+BatchClassesConstructor (size_t size);
+
+
+/**
+ * @brief Destructor for the quadratic_batch_classes structure
+ *
+ * @param classes Pointer to the structure
+ *
+ * @retval NULL
+ */
+quadratic_batch_classes*
+BatchClassesDestructor (quadratic_batch_classes* classes);
+
+
+/**
+ * @brief Groups batch rows indices by class
+ *
+ * @param batch   Pointer to the batch, roots are not used
+ * @param classes Pointer to the classes of at least batch->size capacity
+ *
+ * @retval Status @see quadratic_batch_status
+ * @retval QUADRATIC_BATCH_BAD_ARGS if classes capacity is too small
+ *
+ * @details Classification uses compare masks only,
+ * the indices are stream compacted into per-class lists
+ */
+quadratic_batch_status
+BatchClassify (const quadratic_equation_batch* batch,
+               quadratic_batch_classes*        classes);
+
+
+
+/**
+ * @brief Classifies one equation
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ *
+ * @retval Class of the equation @see quadratic_batch_class
+ */
+quadratic_batch_class
+BatchClassifyRow (double a_coef,
+                  double b_coef,
+                  double c_coef);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+#ifdef __cplusplus
+}
+#endif
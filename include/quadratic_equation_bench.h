@@ -0,0 +1,205 @@
+/**
+ * @file quadratic_equation_bench.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Throughput benchmark of the batch solvers
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_parallel.h"
+#include "perf_counters.h"
+
+
+
+#include <stdint.h>
+
+
+
+//------------------------------------------------------------------------------
+// Benchmark constants
+//------------------------------------------------------------------------------
+
+/// @brief Maximum number of benchmark cases
+#define QUADRATIC_BENCH_MAX_CASES 16
+
+/// @brief Maximum number of latency benchmark cases
+#define QUADRATIC_LATENCY_MAX_CASES 4
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Benchmark structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Options of the benchmark
+ *
+ * @see BenchOptionsInit() for default values
+ */
+typedef
+struct quadratic_bench_options
+{
+    size_t   rows;      ///< Number of equations in the batch
+    size_t   threads;   ///< Number of worker threads, 0 for all CPUs
+    size_t   repeats;   ///< Number of timed solves, the best one is reported
+    uint64_t seed;      ///< Seed of the coefficients
+}
+quadratic_bench_options;
+
+
+/**
+ * @brief Result of one benchmark case
+ */
+typedef
+struct quadratic_bench_result
+{
+    const char* name;               ///< Name of the case
+    double      seconds;            ///< Best solve time
+    double      rows_per_second;    ///< Equations per second
+    double      bytes_per_second;   ///< Columns bytes read and written per second
+    double      speedup;            ///< Time of the first case divided by this one
+    bool        has_counters;       ///< Counters below are measured
+    double      instructions_per_cycle;     ///< IPC, 0 if not counted
+    double      branch_misses_per_row;      ///< Branch misses per equation
+    double      l1_misses_per_row;          ///< L1 data read misses per equation
+    double      llc_misses_per_row;         ///< Last level cache misses per equation
+}
+quadratic_bench_result;
+
+
+/**
+ * @brief Results of all benchmark cases
+ */
+typedef
+struct quadratic_bench_report
+{
+    size_t rows;            ///< Number of equations in the batch
+    size_t threads;         ///< Number of worker threads
+    size_t nodes_number;    ///< Number of NUMA nodes
+    size_t cases_number;    ///< Number of cases
+    quadratic_bench_result cases[QUADRATIC_BENCH_MAX_CASES];   ///< Cases
+}
+quadratic_bench_report;
+
+
+/**
+ * @brief Latency percentiles of one single equation solver
+ */
+typedef
+struct quadratic_latency_result
+{
+    const char* name;       ///< Name of the solver
+    double      p50_ns;     ///< Median solve time, nanoseconds
+    double      p99_ns;     ///< 99th percentile, nanoseconds
+    double      p999_ns;    ///< 99.9th percentile, nanoseconds
+    double      max_ns;     ///< Maximal solve time, nanoseconds
+}
+quadratic_latency_result;
+
+
+/**
+ * @brief Results of all latency benchmark cases
+ */
+typedef
+struct quadratic_latency_report
+{
+    size_t samples;         ///< Timed solves per case
+    size_t cases_number;    ///< Number of cases
+    quadratic_latency_result cases[QUADRATIC_LATENCY_MAX_CASES];   ///< Cases
+}
+quadratic_latency_report;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Benchmark interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes benchmark options with default values
+ *
+ * @param options Pointer to the options
+ *
+ * @details Default values: rows = 4194304, threads = 0, repeats = 5, seed = 1
+ */
+void
+BenchOptionsInit (quadratic_bench_options* options);
+
+
+/**
+ * @brief Runs all benchmark cases
+ *
+ * @param options Pointer to the options, NULL for default ones
+ * @param report  Pointer to the report
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Cases:
+ * batch allocated and filled by the main thread, solved by unpinned workers;
+ * batch placed by BatchParallelConstructor(), solved by pinned workers;
+ * the same with huge pages;
+ * then every batch solver option (classified, routed, sorted, polished,
+ * fast division) and the packed roots
+ * Every case reports its speedup over the first one, so the kernels
+ * are compared with the plain division path on the same machine
+ * If hardware counters are permitted, they are measured over
+ * the timed solves, otherwise only the time is reported
+ */
+quadratic_batch_status
+BenchRun (const quadratic_bench_options* options,
+          quadratic_bench_report*        report);
+
+
+/**
+ * @brief Runs latency benchmark of the single equation solvers
+ *
+ * @param options Pointer to the options, rows is the number of samples,
+ * threads and repeats are not used
+ * @param report  Pointer to the report
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Cases: SolveQuadraticEquation() with CoefsConstructor() and
+ * EndSolver(), HandleInit() of a stack handle and
+ * SolveQuadraticEquationLocal(); every solve is timed alone, the cases
+ * take turns on the same coefficients, so they share the system noise
+ * The times include one clock_gettime() call
+ */
+quadratic_batch_status
+BenchLatencyRun (const quadratic_bench_options* options,
+                 quadratic_latency_report*      report);
+
+
+/**
+ * @brief Fills counters fields of the result
+ *
+ * @param result Pointer to the result
+ * @param values Pointer to the counted values
+ * @param rows   Number of solved equations
+ *
+ * @details has_counters is set if cycles and instructions are counted,
+ * misses that are not counted are left zero
+ */
+void
+BenchSetCounters (quadratic_bench_result*     result,
+                  const perf_counters_values* values,
+                  size_t                      rows);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
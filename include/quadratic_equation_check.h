@@ -0,0 +1,148 @@
+/**
+ * @file quadratic_equation_check.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Differential check of the batch solvers against the scalar one
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_batch.h"
+
+
+
+#include <stdint.h>
+
+
+
+//------------------------------------------------------------------------------
+// Differential check structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Result of the differential check
+ *
+ * @details If diverged is false, only rows_checked is meaningful
+ */
+typedef
+struct quadratic_check_report
+{
+    size_t      rows_checked;   ///< Number of rows compared
+    bool        diverged;       ///< Some variant diverged from the reference
+    const char* variant;        ///< Name of the diverged variant
+    size_t      row;            ///< Index of the first diverged row
+    double      a;              ///< Coefficient before \f$ x^2 \f$ of the row
+    double      b;              ///< Coefficient before \f$ x \f$   of the row
+    double      c;              ///< Free coefficient of the row
+    quadratic_batch_class           row_class;          ///< Class of the row by the reference
+    quadratic_equation_roots_number expected_number;    ///< Reference roots number
+    quadratic_equation_roots_number actual_number;      ///< Variant   roots number
+    double      expected_x1;    ///< Reference first  root
+    double      expected_x2;    ///< Reference second root
+    double      actual_x1;      ///< Variant   first  root
+    double      actual_x2;      ///< Variant   second root
+    uint64_t    ulp_error;      ///< Largest ULP distance between the roots
+    const char* invariant;      ///< Broken invariant of the variant, NULL if only the roots diverged
+}
+quadratic_check_report;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Differential check interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Fills batch coefficients with random and adversarial values
+ *
+ * @param batch Pointer to the batch
+ * @param seed  Seed of the generator, the same seed gives the same batch
+ *
+ * @details Mixes random doubles of wide exponent range with
+ * NaN, infinities, signed zeros, subnormals, DBL_MAX and values around
+ * the comparison tolerance, and with rows whose discriminant is
+ * close to zero
+ */
+void
+CheckFillBatch (quadratic_equation_batch* batch,
+                uint64_t                  seed);
+
+
+/**
+ * @brief Runs every batch solver variant and compares it with the reference
+ *
+ * @param batch  Pointer to the batch with coefficients, roots are overwritten
+ * @param report Pointer to the report
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details The reference is SolveQuadraticEquation() called for every row,
+ * NULL result is treated as QUADRATIC_EQUATION_NOT_SOLVED
+ * Exact variants must match roots number and roots bit to bit (NaN
+ * matches any NaN), polishing variants must match roots number only,
+ * float packed roots must match the reference rounded to float
+ * The report describes the first diverged row of the first diverged variant
+ */
+quadratic_batch_status
+CheckBatchVariants (quadratic_equation_batch* batch,
+                    quadratic_check_report*   report);
+
+
+/**
+ * @brief Checks raw bytes interpreted as coefficients
+ *
+ * @param data   Bytes of the coefficients, three doubles per row
+ * @param size   Number of bytes, incomplete row is ignored
+ * @param report Pointer to the report
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Entry point for coverage guided fuzzers: AFL through
+ * the --fuzz solver mode, libFuzzer through LLVMFuzzerTestOneInput()
+ * compiled with QUADRATIC_EQUATION_FUZZER defined
+ */
+quadratic_batch_status
+CheckRawInput (const uint8_t*          data,
+               size_t                  size,
+               quadratic_check_report* report);
+
+
+/**
+ * @brief Distance between two doubles in units in the last place
+ *
+ * @param x First  double
+ * @param y Second double
+ *
+ * @retval 0          if both are NaN or equal
+ * @retval UINT64_MAX if only one of them is NaN
+ */
+uint64_t
+UlpDistance (double x,
+             double y);
+
+
+/**
+ * @brief Prints the differential check report
+ *
+ * @param report Pointer to the report
+ *
+ * @details Prints number of checked rows or the first diverged row
+ * with its class, expected and actual roots and ULP error
+ */
+void
+PrintCheckReport (const quadratic_check_report* report);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
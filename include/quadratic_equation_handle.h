@@ -0,0 +1,149 @@
+/**
+ * @file quadratic_equation_handle.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Persistent solved equation with incremental re-solve
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation.h"
+
+
+
+//------------------------------------------------------------------------------
+// Handle structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Solved equation with cached intermediate values
+ *
+ * @details The cached values let HandleUpdateA(), HandleUpdateB() and
+ * HandleUpdateC() recompute only what the changed coefficient invalidates:
+ * \f$ b^2 \f$ is kept while a or c changes, \f$ 4a \f$ while b or c changes
+ * and \f$ 4ac \f$ while b changes
+ */
+typedef
+struct quadratic_equation_handle
+{
+    quadratic_equation_coefs coefs;     ///< Coefficients
+    quadratic_equation_roots roots;     ///< Roots, @see SolveQuadraticEquation()
+    double b_square;                    ///< \f$ b^2 \f$
+    double a_quadruple;                 ///< \f$ 4a \f$
+    double ac_quadruple;                ///< \f$ 4ac \f$
+    double discriminant;                ///< \f$ D = b^2 - 4ac \f$
+}
+quadratic_equation_handle;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Handle interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructor for the quadratic_equation_handle structure
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ *
+ * @retval Pointer to the solved handle
+ * @retval NULL if allocation error occured
+ */
+quadratic_equation_handle*
+HandleConstructor (double a_coef,
+                   double b_coef,
+                   double c_coef);
+
+
+/**
+ * @brief Destructor for the quadratic_equation_handle structure
+ *
+ * @param handle Pointer to the structure
+ *
+ * @retval NULL
+ */
+quadratic_equation_handle*
+HandleDestructor (quadratic_equation_handle* handle);
+
+
+/**
+ * @brief Solves the equation from scratch into the handle
+ *
+ * @param handle Pointer to the handle, may be placed anywhere
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ *
+ * @retval Pointer to the roots of the handle
+ * @retval NULL if handle is NULL
+ */
+const quadratic_equation_roots*
+HandleInit (quadratic_equation_handle* handle,
+            double                     a_coef,
+            double                     b_coef,
+            double                     c_coef);
+
+
+/**
+ * @brief Changes coefficient before \f$ x^2 \f$ and re-solves the equation
+ *
+ * @param handle Pointer to the solved handle
+ * @param a_coef New coefficient
+ *
+ * @retval Pointer to the roots of the handle
+ * @retval NULL if handle is NULL
+ *
+ * @details Recomputes \f$ 4a \f$, \f$ 4ac \f$ and D
+ */
+const quadratic_equation_roots*
+HandleUpdateA (quadratic_equation_handle* handle,
+               double                     a_coef);
+
+
+/**
+ * @brief Changes coefficient before \f$ x \f$ and re-solves the equation
+ *
+ * @param handle Pointer to the solved handle
+ * @param b_coef New coefficient
+ *
+ * @retval Pointer to the roots of the handle
+ * @retval NULL if handle is NULL
+ *
+ * @details Recomputes \f$ b^2 \f$ and D
+ */
+const quadratic_equation_roots*
+HandleUpdateB (quadratic_equation_handle* handle,
+               double                     b_coef);
+
+
+/**
+ * @brief Changes free coefficient and re-solves the equation
+ *
+ * @param handle Pointer to the solved handle
+ * @param c_coef New coefficient
+ *
+ * @retval Pointer to the roots of the handle
+ * @retval NULL if handle is NULL
+ *
+ * @details Recomputes \f$ 4ac \f$ and D
+ */
+const quadratic_equation_roots*
+HandleUpdateC (quadratic_equation_handle* handle,
+               double                     c_coef);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,47 @@
+/**
+ * @file quadratic_equation_local.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Low latency solver of single equations with per-thread contexts
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation.h"
+
+
+
+//------------------------------------------------------------------------------
+// Local solver interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Solves the equation into the context of the calling thread
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ *
+ * @retval Pointer to the roots of the thread context,
+ * valid until the next call from the same thread
+ *
+ * @details Gives the same roots as SolveQuadraticEquation(),
+ * but nothing is allocated or locked and only one sqrt() is called;
+ * NaN discriminant gives QUADRATIC_EQUATION_NOT_SOLVED instead of NULL
+ */
+const quadratic_equation_roots*
+SolveQuadraticEquationLocal (double a_coef,
+                             double b_coef,
+                             double c_coef);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,173 @@
+/**
+ * @file quadratic_equation_packed.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Packed encoding of the batch roots
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_batch.h"
+
+
+
+//------------------------------------------------------------------------------
+// Packed roots constants
+//------------------------------------------------------------------------------
+
+/// @brief Rows per entry of the offsets index
+#define QUADRATIC_PACKED_BLOCK_ROWS 64
+
+/// @brief Number of entries of the offsets index for the given rows number
+#define QUADRATIC_PACKED_BLOCKS(size) \
+    (((size) + QUADRATIC_PACKED_BLOCK_ROWS - 1) / QUADRATIC_PACKED_BLOCK_ROWS)
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Packed roots structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Roots of a batch with only the valid roots stored
+ *
+ * @details Row i has roots_number[i] (one byte) and
+ * 1 root for QUADRATIC_EQUATION_ONE_ROOT, 2 roots for
+ * QUADRATIC_EQUATION_TWO_ROOTS and no roots otherwise;
+ * the roots of all rows follow each other in the roots stream,
+ * block_offsets[k] is the index in the stream of the first root of
+ * rows from k * QUADRATIC_PACKED_BLOCK_ROWS
+ * Roots are double, or float if is_float is set
+ */
+typedef
+struct quadratic_packed_roots
+{
+    size_t   capacity;          ///< Maximum number of rows
+    bool     is_float;          ///< Roots are rounded to float
+    size_t   size;              ///< Number of encoded rows
+    size_t   roots_size;        ///< Number of stored roots
+    uint8_t* roots_number;      ///< Numbers of roots
+    size_t*  block_offsets;     ///< Offsets index of the roots stream
+    void*    roots;             ///< Roots stream, double or float
+}
+quadratic_packed_roots;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Packed roots interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructor for the quadratic_packed_roots structure
+ *
+ * @param capacity Maximum number of rows
+ * @param is_float Round the roots to float, halving the roots stream
+ *
+ * @retval Pointer to the structure with room for 2 * capacity roots
+ * @retval NULL if allocation error occured
+ *
+ * @note With is_float the roots are rounded to nearest float,
+ * roots above FLT_MAX in magnitude become infinities of their sign
+ * and roots below the float subnormal range become signed zeros
+ */
+quadratic_packed_roots*
+PackedRootsConstructor (size_t capacity,
+                        bool   is_float);
+
+
+/**
+ * @brief Destructor for the quadratic_packed_roots structure
+ *
+ * @param packed Pointer to the structure
+ *
+ * @retval NULL
+ */
+quadratic_packed_roots*
+PackedRootsDestructor (quadratic_packed_roots* packed);
+
+
+/**
+ * @brief Encodes the roots of the solved batch
+ *
+ * @param packed Pointer to the packed roots of at least batch->size capacity
+ * @param batch  Pointer to the solved batch
+ *
+ * @retval Status @see quadratic_batch_status
+ * @retval QUADRATIC_BATCH_BAD_ARGS if the capacity is too small
+ *
+ * @details Both roots of every row are written to the end of the stream
+ * and the stream grows by the number of valid roots of the row,
+ * so there are no branches on the roots numbers
+ */
+quadratic_batch_status
+PackedRootsEncode (quadratic_packed_roots*         packed,
+                   const quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Decodes the roots to the batch roots columns
+ *
+ * @param packed Pointer to the encoded roots
+ * @param batch  Pointer to the batch of packed->size rows,
+ * coefficients columns are not written
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Absent roots are NaN as after SolveQuadraticBatch(),
+ * they are selected, not branched on
+ */
+quadratic_batch_status
+PackedRootsDecode (const quadratic_packed_roots* packed,
+                   quadratic_equation_batch*     batch);
+
+
+/**
+ * @brief Decodes the roots of one row
+ *
+ * @param packed Pointer to the encoded roots
+ * @param row    Row index, less than packed->size
+ * @param x1     Pointer to the first  root, NaN if absent
+ * @param x2     Pointer to the second root, NaN if absent
+ *
+ * @retval Number of roots of the row
+ * @retval QUADRATIC_EQUATION_NOT_SOLVED if some pointer is NULL
+ * or the row is out of range
+ *
+ * @details Finds the root offset from the offsets index and
+ * the roots numbers of at most QUADRATIC_PACKED_BLOCK_ROWS - 1 rows
+ */
+quadratic_equation_roots_number
+PackedRootsGet (const quadratic_packed_roots* packed,
+                size_t                        row,
+                double*                       x1,
+                double*                       x2);
+
+
+/**
+ * @brief Finds the size of the encoded roots
+ *
+ * @param packed Pointer to the encoded roots
+ *
+ * @retval Bytes of the roots numbers, the offsets index and the roots stream
+ */
+size_t
+PackedRootsBytes (const quadratic_packed_roots* packed);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,141 @@
+/**
+ * @file quadratic_equation_parallel.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Multithreaded and NUMA-aware batch solver
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_batch.h"
+
+
+
+//------------------------------------------------------------------------------
+// Parallel solver structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Options of the parallel batch solver
+ *
+ * @see ParallelOptionsInit() for default values
+ */
+typedef
+struct quadratic_parallel_options
+{
+    size_t threads;     ///< Number of worker threads, 0 for all CPUs
+    bool   numa_aware;  ///< Pin workers to NUMA nodes
+    bool   huge_pages;  ///< Advise huge pages for the batch columns
+    quadratic_batch_options solve;  ///< Options of every chunk solve
+}
+quadratic_parallel_options;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Parallel solver interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes parallel solver options with default values
+ *
+ * @param options Pointer to the options
+ *
+ * @details Default values: threads = 0, numa_aware = false,
+ * huge_pages = false, solve is initialized by BatchOptionsInit()
+ */
+void
+ParallelOptionsInit (quadratic_parallel_options* options);
+
+
+/**
+ * @brief Constructor for the batch with first-touch column placement
+ *
+ * @param size    Number of equations
+ * @param options Pointer to the options, NULL for default ones
+ *
+ * @retval Pointer to the batch
+ * @retval NULL if allocation error occured
+ *
+ * @details All columns are placed in one anonymous memory mapping
+ * (huge pages are advised if options->huge_pages is set)
+ * Every chunk of every column is initialized by the worker that will
+ * solve it, pinned to its NUMA node if options->numa_aware is set,
+ * so the kernel places the pages on that node
+ * Pass the same options to SolveQuadraticBatchParallel()
+ * The batch is destroyed by BatchDestructor()
+ */
+quadratic_equation_batch*
+BatchParallelConstructor (size_t                            size,
+                          const quadratic_parallel_options* options);
+
+
+/**
+ * @brief Solves the batch by several threads
+ *
+ * @param batch   Pointer to the batch
+ * @param options Pointer to the options, NULL for default ones
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details The batch is split into page aligned contiguous chunks,
+ * one per thread, every chunk is solved by SolveQuadraticBatch()
+ * If options->numa_aware is set, the threads are spread over NUMA nodes
+ * in the same order as BatchParallelConstructor() does
+ * Results are the same as the ones of SolveQuadraticBatch()
+ */
+quadratic_batch_status
+SolveQuadraticBatchParallel (quadratic_equation_batch*         batch,
+                             const quadratic_parallel_options* options);
+
+
+/**
+ * @brief Solves the batch by several threads until the token is cancelled
+ *
+ * @param batch       Pointer to the batch
+ * @param options     Pointer to the options, NULL for default ones
+ * @param token       Pointer to the token, NULL to solve all rows
+ * @param solved_rows Pointer to the number of solved rows, may be NULL
+ *
+ * @retval Status @see quadratic_batch_status
+ * @retval QUADRATIC_BATCH_CANCELLED if some rows are not solved
+ *
+ * @details Workers claim chunks of QUADRATIC_BATCH_CANCEL_CHUNK_ROWS rows
+ * in row order and check the token before every claim; claimed chunks
+ * are always solved, so the solved rows are the first *solved_rows ones
+ * as in SolveQuadraticBatchCancellable()
+ * Workers are still pinned if options->numa_aware is set, but chunks are
+ * not bound to the node that placed them: a shared cursor keeps the solved
+ * rows a prefix, so a cancelled solve is resumed from one row, at the cost
+ * of remote memory reads for the chunks another node claims
+ * Use SolveQuadraticBatchParallel() when placement matters more than cancellation
+ */
+quadratic_batch_status
+SolveQuadraticBatchParallelCancellable (quadratic_equation_batch*         batch,
+                                        const quadratic_parallel_options* options,
+                                        quadratic_cancel_token*           token,
+                                        size_t*                           solved_rows);
+
+
+/**
+ * @brief Returns number of NUMA nodes of the host
+ *
+ * @retval Number of nodes, 1 if the topology is not available
+ */
+size_t
+ParallelNumaNodesNumber (void);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
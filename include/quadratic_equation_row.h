@@ -0,0 +1,121 @@
+/**
+ * @file quadratic_equation_row.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Row solver shared by the batch, handle and thread-local solvers
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation.h"
+#include "doubles_compare.h"
+
+
+
+//------------------------------------------------------------------------------
+// Row solver
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Solves one equation with the given discriminant
+ *
+ * @param a_coef       Coefficient before \f$ x^2 \f$
+ * @param b_coef       Coefficient before \f$ x \f$
+ * @param c_coef       Free coefficient
+ * @param discriminant \f$ b^2 - 4ac \f$, computed by the caller
+ * @param x1           Pointer to the first  root
+ * @param x2           Pointer to the second root
+ *
+ * @retval Number of roots
+ *
+ * @details Follows CalculateRoots() rules, missing roots are NaN,
+ * the discriminant is not read in the linear case
+ */
+static inline quadratic_equation_roots_number
+SolveQuadraticRowByDiscriminant (double  a_coef,
+                                 double  b_coef,
+                                 double  c_coef,
+                                 double  discriminant,
+                                 double* x1,
+                                 double* x2)
+{
+    *x1 = NAN;
+    *x2 = NAN;
+
+    if (CompareDoubles (a_coef, 0) == DOUBLES_CMP_EQUAL)
+    {
+        doubles_cmp_status b_cmp_status = CompareDoubles (b_coef, 0);
+        doubles_cmp_status c_cmp_status = CompareDoubles (c_coef, 0);
+
+        if (b_cmp_status == DOUBLES_CMP_EQUAL)
+            return (c_cmp_status == DOUBLES_CMP_EQUAL) ?
+                   QUADRATIC_EQUATION_INF_ROOTS :
+                   QUADRATIC_EQUATION_NO_ROOTS;
+
+        *x1 = -c_coef / b_coef;
+        return QUADRATIC_EQUATION_ONE_ROOT;
+    }
+
+    switch (CompareDoubles (discriminant, 0))
+    {
+        case DOUBLES_CMP_LESS:
+            return QUADRATIC_EQUATION_NO_ROOTS;
+
+        case DOUBLES_CMP_EQUAL:
+            *x1 = -b_coef / 2 / a_coef;
+            return QUADRATIC_EQUATION_ONE_ROOT;
+
+        case DOUBLES_CMP_GREATER:
+        {
+            const double discriminant_sqrt = sqrt (discriminant);
+
+            *x1 = (-b_coef - discriminant_sqrt) / 2 / a_coef;
+            *x2 = (-b_coef + discriminant_sqrt) / 2 / a_coef;
+            return QUADRATIC_EQUATION_TWO_ROOTS;
+        }
+
+        case DOUBLES_CMP_UNDEFINED:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        default:
+            return QUADRATIC_EQUATION_NOT_SOLVED;
+    }
+}
+
+
+/**
+ * @brief Solves one equation
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ * @param x1     Pointer to the first  root
+ * @param x2     Pointer to the second root
+ *
+ * @retval Number of roots, @see SolveQuadraticRowByDiscriminant()
+ */
+static inline quadratic_equation_roots_number
+SolveQuadraticRow (double  a_coef,
+                   double  b_coef,
+                   double  c_coef,
+                   double* x1,
+                   double* x2)
+{
+    return SolveQuadraticRowByDiscriminant (a_coef, b_coef, c_coef,
+                                            b_coef * b_coef - 4 * a_coef * c_coef,
+                                            x1, x2);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
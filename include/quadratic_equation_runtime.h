@@ -0,0 +1,283 @@
+/**
+ * @file quadratic_equation_runtime.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Shared solver runtime with priorities and per-tenant fair queues
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_batch.h"
+
+
+
+//------------------------------------------------------------------------------
+// Solver runtime constants
+//------------------------------------------------------------------------------
+
+/// @brief Buckets of the wait time histogram, bucket k counts waits
+/// in \f$ [2^{k-1}, 2^k) \f$ microseconds (bucket 0 is below 1 us)
+#define QUADRATIC_RUNTIME_WAIT_BUCKETS 32
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Solver runtime structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Solver runtime, @see RuntimeConstructor()
+ */
+typedef
+struct quadratic_runtime
+quadratic_runtime;
+
+
+/**
+ * @brief Solve job
+ */
+typedef
+struct quadratic_runtime_job
+quadratic_runtime_job;
+
+
+/**
+ * @brief Priority classes of the jobs
+ */
+typedef
+enum quadratic_priority
+{
+    QUADRATIC_PRIORITY_INTERACTIVE = 0, ///< Latency-sensitive, served first
+    QUADRATIC_PRIORITY_BULK        = 1, ///< Throughput-oriented
+    QUADRATIC_PRIORITY_COUNT       = 2  ///< Number of priority classes
+}
+quadratic_priority;
+
+
+/**
+ * @brief Completion callback
+ *
+ * @param job       Pointer to the completed job
+ * @param user_data User data given to RuntimeSubmit()
+ *
+ * @details Called by a worker thread after the job is marked done and
+ * counted in the metrics, as the last access of the runtime to the job,
+ * so the callback may free the job or resume a task that frees it
+ * It must not block
+ */
+typedef
+void (*quadratic_runtime_callback) (quadratic_runtime_job* job,
+                                    void*                  user_data);
+
+
+/**
+ * @brief Solve job, owned by the caller
+ *
+ * @details Fields are set by RuntimeSubmit(), the job memory and
+ * the batch columns must stay valid until the job is done
+ */
+struct quadratic_runtime_job
+{
+    quadratic_equation_batch*  batch;           ///< Batch view to solve in place
+    size_t                     tenant;          ///< Tenant of the job
+    quadratic_priority         priority;        ///< Priority class of the job
+    quadratic_runtime_callback callback;        ///< Completion callback, may be NULL
+    void*                      user_data;       ///< Argument of the callback
+    quadratic_batch_status     status;          ///< Result, valid when done
+    bool                       done;            ///< Job is completed
+    size_t                     next_row;        ///< First row of the next slice
+    size_t                     running_slices;  ///< Slices being solved
+    double                     submit_time;     ///< Time of RuntimeSubmit()
+    quadratic_runtime_job*     next;            ///< Next job of the tenant queue
+};
+
+
+/**
+ * @brief Options of the solver runtime
+ *
+ * @see RuntimeOptionsInit() for default values
+ */
+typedef
+struct quadratic_runtime_options
+{
+    size_t threads;             ///< Number of worker threads, 0 for all CPUs
+    size_t tenants_number;      ///< Tenants are numbered from 0 to tenants_number - 1
+    size_t slice_rows;          ///< Rows of one time slice of a job
+    size_t interactive_burst;   ///< Interactive slices in a row while bulk waits
+    quadratic_batch_options solve;  ///< Options of every slice solve
+}
+quadratic_runtime_options;
+
+
+/**
+ * @brief Metrics of one priority class
+ */
+typedef
+struct quadratic_runtime_class_metrics
+{
+    size_t queued_jobs;         ///< Jobs with rows not yet started
+    size_t queued_rows;         ///< Rows not yet started
+    size_t submitted_jobs;      ///< Jobs submitted since the start
+    size_t completed_jobs;      ///< Jobs completed since the start
+    size_t solved_rows;         ///< Rows solved since the start
+    double wait_seconds_total;  ///< Sum of the waits from submit to the first slice
+    double wait_seconds_max;    ///< Maximal wait
+    size_t wait_histogram[QUADRATIC_RUNTIME_WAIT_BUCKETS];  ///< Waits by magnitude
+}
+quadratic_runtime_class_metrics;
+
+
+/**
+ * @brief Metrics of the runtime
+ */
+typedef
+struct quadratic_runtime_metrics
+{
+    quadratic_runtime_class_metrics classes[QUADRATIC_PRIORITY_COUNT];  ///< By priority
+}
+quadratic_runtime_metrics;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Solver runtime interface
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes solver runtime options with default values
+ *
+ * @param options Pointer to the options
+ *
+ * @details Default values: threads = 0, tenants_number = 64,
+ * slice_rows = QUADRATIC_BATCH_CANCEL_CHUNK_ROWS, interactive_burst = 8,
+ * solve is initialized by BatchOptionsInit()
+ */
+void
+RuntimeOptionsInit (quadratic_runtime_options* options);
+
+
+/**
+ * @brief Constructor for the solver runtime
+ *
+ * @param options Pointer to the options, NULL for default ones
+ *
+ * @retval Pointer to the runtime with started workers
+ * @retval NULL if allocation or thread start error occured
+ */
+quadratic_runtime*
+RuntimeConstructor (const quadratic_runtime_options* options);
+
+
+/**
+ * @brief Destructor for the solver runtime
+ *
+ * @param runtime Pointer to the runtime
+ *
+ * @retval NULL
+ *
+ * @details Completes all submitted jobs and joins the workers
+ */
+quadratic_runtime*
+RuntimeDestructor (quadratic_runtime* runtime);
+
+
+/**
+ * @brief Submits the batch to be solved without waiting
+ *
+ * @param runtime   Pointer to the runtime
+ * @param job       Pointer to the job to fill and enqueue
+ * @param batch     Pointer to the batch, solved in place
+ * @param tenant    Tenant of the job, less than tenants_number
+ * @param priority  Priority class of the job
+ * @param callback  Completion callback, may be NULL
+ * @param user_data Argument of the callback
+ *
+ * @retval QUADRATIC_BATCH_SUCCESS if the job is enqueued
+ * @retval QUADRATIC_BATCH_BAD_ARGS if some pointer is NULL,
+ * the tenant or the priority is out of range
+ *
+ * @details Jobs are solved by slices of slice_rows rows
+ * Every free worker takes the next slice of the interactive class,
+ * unless interactive_burst interactive slices were taken in a row
+ * while bulk jobs wait; within a class the tenants with queued jobs
+ * take slices in turn (round robin), and jobs of one tenant
+ * are served in submit order
+ * A single equation is a job with a one row batch view
+ */
+quadratic_batch_status
+RuntimeSubmit (quadratic_runtime*         runtime,
+               quadratic_runtime_job*     job,
+               quadratic_equation_batch*  batch,
+               size_t                     tenant,
+               quadratic_priority         priority,
+               quadratic_runtime_callback callback,
+               void*                      user_data);
+
+
+/**
+ * @brief Checks whether the job is done without blocking
+ *
+ * @param runtime Pointer to the runtime
+ * @param job     Pointer to the submitted job
+ *
+ * @retval true if the job is done, its status is valid
+ */
+bool
+RuntimePoll (quadratic_runtime*     runtime,
+             quadratic_runtime_job* job);
+
+
+/**
+ * @brief Waits for the job to be done
+ *
+ * @param runtime Pointer to the runtime
+ * @param job     Pointer to the submitted job
+ *
+ * @retval Status of the job @see quadratic_batch_status
+ */
+quadratic_batch_status
+RuntimeWait (quadratic_runtime*     runtime,
+             quadratic_runtime_job* job);
+
+
+/**
+ * @brief Copies the current metrics of the runtime
+ *
+ * @param runtime Pointer to the runtime
+ * @param metrics Pointer to the metrics to fill
+ */
+void
+RuntimeGetMetrics (quadratic_runtime*         runtime,
+                   quadratic_runtime_metrics* metrics);
+
+
+/**
+ * @brief Estimates the wait time percentile from the histogram
+ *
+ * @param metrics  Pointer to the class metrics
+ * @param fraction Fraction of the waits, e.g. 0.99
+ *
+ * @retval Upper bound of the histogram bucket holding the percentile, seconds
+ * @retval 0 if no job has started
+ */
+double
+RuntimeWaitPercentile (const quadratic_runtime_class_metrics* metrics,
+                       double                                 fraction);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
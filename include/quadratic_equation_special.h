@@ -0,0 +1,298 @@
+/**
+ * @file quadratic_equation_special.h
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Solvers specialized for known coefficient patterns
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#pragma once
+
+
+
+#include "quadratic_equation_batch.h"
+#include "doubles_compare.h"
+
+
+
+//------------------------------------------------------------------------------
+// Specialized solvers structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Coefficient patterns with specialized solvers
+ *
+ * @details Patterns are checked in this order, the first matching wins
+ */
+typedef
+enum quadratic_batch_pattern
+{
+    QUADRATIC_PATTERN_GENERAL      = 0, ///< No known pattern
+    QUADRATIC_PATTERN_MONIC        = 1, ///< a == 1
+    QUADRATIC_PATTERN_PURE         = 2, ///< b == 0, a is finite and not zero
+    QUADRATIC_PATTERN_NO_FREE_TERM = 3, ///< c == 0, a is finite and not zero
+    QUADRATIC_PATTERN_COUNT        = 4  ///< Number of patterns
+}
+quadratic_batch_pattern;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Specialized scalar solvers
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Solves monic equation \f$ x^2 + bx + c = 0 \f$
+ *
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ * @param x1     Pointer to the first  root
+ * @param x2     Pointer to the second root
+ *
+ * @retval Number of roots
+ *
+ * @details The same roots as SolveQuadraticEquation() gives for a == 1,
+ * without the linear case check, the multiply by a and the divides by a
+ */
+static inline quadratic_equation_roots_number
+SolveMonicEquation (double  b_coef,
+                    double  c_coef,
+                    double* x1,
+                    double* x2)
+{
+    *x1 = NAN;
+    *x2 = NAN;
+
+    const double discriminant = b_coef * b_coef - 4 * c_coef;
+
+    switch (CompareDoubles (discriminant, 0))
+    {
+        case DOUBLES_CMP_LESS:
+            return QUADRATIC_EQUATION_NO_ROOTS;
+
+        case DOUBLES_CMP_EQUAL:
+            *x1 = -b_coef / 2;
+            return QUADRATIC_EQUATION_ONE_ROOT;
+
+        case DOUBLES_CMP_GREATER:
+        {
+            const double discriminant_sqrt = sqrt (discriminant);
+            *x1 = (-b_coef - discriminant_sqrt) / 2;
+            *x2 = (-b_coef + discriminant_sqrt) / 2;
+            return QUADRATIC_EQUATION_TWO_ROOTS;
+        }
+
+        case DOUBLES_CMP_UNDEFINED:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        default:
+            return QUADRATIC_EQUATION_NOT_SOLVED;
+    }
+}
+
+
+/**
+ * @brief Solves pure quadratic equation \f$ ax^2 + c = 0 \f$
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param c_coef Free coefficient
+ * @param x1     Pointer to the first  root
+ * @param x2     Pointer to the second root
+ *
+ * @retval Number of roots
+ *
+ * @details The same roots as SolveQuadraticEquation() gives for b == 0
+ * (the only root of D == 0 is zero of any sign),
+ * the second root is found once and negated for the first one
+ */
+static inline quadratic_equation_roots_number
+SolvePureQuadraticEquation (double  a_coef,
+                            double  c_coef,
+                            double* x1,
+                            double* x2)
+{
+    *x1 = NAN;
+    *x2 = NAN;
+
+    if (CompareDoubles (a_coef, 0) == DOUBLES_CMP_EQUAL)
+        return (CompareDoubles (c_coef, 0) == DOUBLES_CMP_EQUAL) ?
+               QUADRATIC_EQUATION_INF_ROOTS :
+               QUADRATIC_EQUATION_NO_ROOTS;
+
+    const double discriminant = -4 * a_coef * c_coef;
+
+    switch (CompareDoubles (discriminant, 0))
+    {
+        case DOUBLES_CMP_LESS:
+            return QUADRATIC_EQUATION_NO_ROOTS;
+
+        case DOUBLES_CMP_EQUAL:
+            *x1 = 0;
+            return QUADRATIC_EQUATION_ONE_ROOT;
+
+        case DOUBLES_CMP_GREATER:
+            *x2 = sqrt (discriminant) / 2 / a_coef;
+            *x1 = -*x2;
+            return QUADRATIC_EQUATION_TWO_ROOTS;
+
+        case DOUBLES_CMP_UNDEFINED:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        default:
+            return QUADRATIC_EQUATION_NOT_SOLVED;
+    }
+}
+
+
+/**
+ * @brief Solves equation without free term \f$ ax^2 + bx = 0 \f$
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param x1     Pointer to the first  root
+ * @param x2     Pointer to the second root
+ *
+ * @retval Number of roots
+ *
+ * @details The same roots as SolveQuadraticEquation() gives for c == 0
+ * (zero roots may differ in sign), \f$ D = b^2 \f$,
+ * so \f$ \sqrt{D} = |b| \f$ while \f$ b^2 \f$ does not overflow:
+ * neither \f$ 4ac \f$ nor the square root is computed
+ * (infinite \f$ 4a \f$ gives NaN \f$ 4ac \f$, so the equation is not solved)
+ */
+static inline quadratic_equation_roots_number
+SolveNoFreeTermEquation (double  a_coef,
+                         double  b_coef,
+                         double* x1,
+                         double* x2)
+{
+    *x1 = NAN;
+    *x2 = NAN;
+
+    if (CompareDoubles (a_coef, 0) == DOUBLES_CMP_EQUAL)
+    {
+        if (CompareDoubles (b_coef, 0) == DOUBLES_CMP_EQUAL)
+            return QUADRATIC_EQUATION_INF_ROOTS;
+
+        *x1 = -0.0 / b_coef;
+        return QUADRATIC_EQUATION_ONE_ROOT;
+    }
+
+    if (!isfinite (4 * a_coef)) return QUADRATIC_EQUATION_NOT_SOLVED;
+
+    const double discriminant = b_coef * b_coef;
+
+    switch (CompareDoubles (discriminant, 0))
+    {
+        case DOUBLES_CMP_EQUAL:
+            *x1 = -b_coef / 2 / a_coef;
+            return QUADRATIC_EQUATION_ONE_ROOT;
+
+        case DOUBLES_CMP_GREATER:
+        {
+            const double discriminant_sqrt =
+                isinf (discriminant) ? discriminant : fabs (b_coef);
+            *x1 = (-b_coef - discriminant_sqrt) / 2 / a_coef;
+            *x2 = (-b_coef + discriminant_sqrt) / 2 / a_coef;
+            return QUADRATIC_EQUATION_TWO_ROOTS;
+        }
+
+        case DOUBLES_CMP_LESS:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        case DOUBLES_CMP_UNDEFINED:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        default:
+            return QUADRATIC_EQUATION_NOT_SOLVED;
+    }
+}
+
+
+/**
+ * @brief Finds the pattern of the equation without branches
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ *
+ * @retval Pattern @see quadratic_batch_pattern
+ */
+static inline quadratic_batch_pattern
+BatchPatternRow (double a_coef,
+                 double b_coef,
+                 double c_coef)
+{
+    const int is_monic     = (a_coef >= 1) & (a_coef <= 1);
+    const int is_quadratic = (fabs (a_coef) > DOUBLES_CMP_TOLERANCE) &
+                             (fabs (a_coef) <= DBL_MAX);
+    const int is_pure      = (b_coef >= 0) & (b_coef <= 0) & is_quadratic;
+    const int is_no_free   = (c_coef >= 0) & (c_coef <= 0) & is_quadratic;
+
+    return (quadratic_batch_pattern)
+           (is_monic * QUADRATIC_PATTERN_MONIC +
+            (1 - is_monic) * (is_pure * QUADRATIC_PATTERN_PURE +
+                              (1 - is_pure) * is_no_free *
+                              QUADRATIC_PATTERN_NO_FREE_TERM));
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Specialized batch solvers
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Solves every equation of the batch as monic one
+ *
+ * @param batch Pointer to the batch, column a is not read
+ *
+ * @retval Status @see quadratic_batch_status
+ */
+quadratic_batch_status
+SolveMonicBatch (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Solves every equation of the batch as pure quadratic one
+ *
+ * @param batch Pointer to the batch, column b is not read
+ *
+ * @retval Status @see quadratic_batch_status
+ */
+quadratic_batch_status
+SolvePureQuadraticBatch (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Solves every equation of the batch as one without free term
+ *
+ * @param batch Pointer to the batch, column c is not read
+ *
+ * @retval Status @see quadratic_batch_status
+ */
+quadratic_batch_status
+SolveNoFreeTermBatch (quadratic_equation_batch* batch);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
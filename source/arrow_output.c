@@ -0,0 +1,782 @@
+/**
+ * @file arrow_output.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Apache Arrow IPC stream writer implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ *
+ * @details The metadata flatbuffers are built front to back:
+ * every table is preceded by its vtable and is followed by its children,
+ * offsets to children are patched when the children are written
+ * The host is expected to be little endian, as the Arrow format is
+ */
+
+
+
+#include "arrow_output.h"
+
+
+
+#include <string.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Arrow MetadataVersion V5
+static const int16_t ARROW_METADATA_VERSION = 4;
+
+/// @brief MessageHeader union types
+static const uint8_t ARROW_HEADER_SCHEMA       = 1;
+static const uint8_t ARROW_HEADER_RECORD_BATCH = 3;
+
+/// @brief Type union types
+enum
+{
+    ARROW_TYPE_INT            = 2,
+    ARROW_TYPE_FLOATING_POINT = 3
+};
+
+/// @brief FloatingPoint precision DOUBLE
+static const int16_t ARROW_PRECISION_DOUBLE = 2;
+
+/// @brief Continuation marker of the encapsulated message
+static const uint32_t ARROW_CONTINUATION = 0xFFFFFFFF;
+
+/// @brief Alignment of the metadata and the body buffers
+static const size_t ARROW_ALIGNMENT = 8;
+
+/// @brief Maximal number of rows in one record batch of ArrowWriteBatch()
+static const size_t ARROW_MAX_BATCH_ROWS = 1 << 16;
+
+/// @brief Number of columns and buffers of the record batch
+enum
+{
+    ARROW_COLUMNS_NUMBER = 3,
+    ARROW_BUFFERS_NUMBER = 2 * ARROW_COLUMNS_NUMBER
+};
+
+/// @brief Maximal number of fields in the encoded tables
+enum { FLATBUFFER_MAX_FIELDS = 8 };
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Flatbuffer being built
+ */
+typedef
+struct flatbuffer_builder
+{
+    arrow_buffer bytes;     ///< Encoded bytes
+    bool         failed;    ///< Allocation error occured
+}
+flatbuffer_builder;
+
+
+/**
+ * @brief Field of the flatbuffer table
+ */
+typedef
+struct flatbuffer_field
+{
+    size_t      id;         ///< Field id in the schema
+    size_t      size;       ///< Field size, 4 for offsets
+    const void* value;      ///< Pointer to the value, NULL for offsets
+    size_t      position;   ///< Position of the written field
+}
+flatbuffer_field;
+
+
+/**
+ * @brief Description of one column
+ */
+typedef
+struct arrow_column
+{
+    const char* name;       ///< Column name
+    bool        nullable;   ///< Column may have nulls
+    uint8_t     type_type;  ///< Type union type
+}
+arrow_column;
+
+/// @brief Columns of the roots schema
+static const arrow_column ARROW_COLUMNS[ARROW_COLUMNS_NUMBER] =
+{
+    {"x1",           true,  ARROW_TYPE_FLOATING_POINT},
+    {"x2",           true,  ARROW_TYPE_FLOATING_POINT},
+    {"roots_number", false, ARROW_TYPE_INT}
+};
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Reserves space for extra bytes in the buffer
+ *
+ * @retval true upon success, false if allocation error occured
+ */
+static bool
+ReserveBytes (arrow_buffer* buffer,
+              size_t        extra);
+
+
+/**
+ * @brief Appends bytes to the flatbuffer
+ *
+ * @retval Position of the bytes
+ */
+static size_t
+FlatbufferAppend (flatbuffer_builder* builder,
+                  const void*         bytes,
+                  size_t              size);
+
+
+/**
+ * @brief Pads the flatbuffer with zeros up to the alignment
+ */
+static void
+FlatbufferAlign (flatbuffer_builder* builder,
+                 size_t              alignment);
+
+
+/**
+ * @brief Writes the offset to the target at the position
+ */
+static void
+FlatbufferPatch (flatbuffer_builder* builder,
+                 size_t              position,
+                 size_t              target);
+
+
+/**
+ * @brief Writes vtable and table with the fields
+ *
+ * @param builder Pointer to the builder
+ * @param fields  Fields of the table, positions are filled
+ * @param count   Number of fields
+ *
+ * @retval Position of the table
+ *
+ * @details Offset fields are written as zeros to be patched
+ */
+static size_t
+FlatbufferTable (flatbuffer_builder* builder,
+                 flatbuffer_field*   fields,
+                 size_t              count);
+
+
+/**
+ * @brief Writes vector of structs
+ *
+ * @retval Position of the vector
+ */
+static size_t
+FlatbufferStructVector (flatbuffer_builder* builder,
+                        const void*         elements,
+                        size_t              count,
+                        size_t              element_size);
+
+
+/**
+ * @brief Writes vector of offsets to be patched
+ *
+ * @retval Position of the vector, element i is at position + 4 + 4 * i
+ */
+static size_t
+FlatbufferOffsetVector (flatbuffer_builder* builder,
+                        size_t              count);
+
+
+/**
+ * @brief Writes string
+ *
+ * @retval Position of the string
+ */
+static size_t
+FlatbufferString (flatbuffer_builder* builder,
+                  const char*         string);
+
+
+/**
+ * @brief Writes Message table with the given header
+ *
+ * @retval Position of the header offset to be patched
+ */
+static size_t
+EncodeMessage (flatbuffer_builder* builder,
+               uint8_t             header_type,
+               int64_t             body_length);
+
+
+/**
+ * @brief Writes RecordBatch message metadata
+ *
+ * @param builder     Pointer to the builder
+ * @param rows        Number of rows
+ * @param nodes       FieldNode structs of the columns
+ * @param buffers     Buffer structs of the body
+ * @param body_length Body length
+ *
+ * @details The metadata size does not depend on the values
+ */
+static void
+EncodeRecordBatchMetadata (flatbuffer_builder* builder,
+                           size_t              rows,
+                           const int64_t*      nodes,
+                           const int64_t*      buffers,
+                           size_t              body_length);
+
+
+/**
+ * @brief Appends the encapsulated message to the buffer
+ *
+ * @param buffer      Pointer to the buffer
+ * @param builder     Pointer to the built metadata
+ * @param body_length Body length, the body is appended by the caller
+ *
+ * @retval Status @see arrow_output_status
+ */
+static arrow_output_status
+AppendMessage (arrow_buffer*       buffer,
+               flatbuffer_builder* builder,
+               size_t              body_length);
+
+
+/**
+ * @brief Writes validity bitmap and values of the roots column
+ *
+ * @param roots  Roots column
+ * @param rows   Number of rows
+ * @param bitmap Output validity bitmap
+ * @param values Output values, nulls are zeros
+ *
+ * @retval Number of nulls
+ */
+static size_t
+EncodeRootsColumn (const double* roots,
+                   size_t        rows,
+                   uint8_t*      bitmap,
+                   uint8_t*      values);
+
+
+/**
+ * @brief Rounds the size up to the alignment
+ */
+static inline size_t
+AlignSize (size_t size,
+           size_t alignment);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Arrow writer interface implementation
+//------------------------------------------------------------------------------
+
+arrow_output_status
+ArrowEncodeSchema (arrow_buffer* buffer)
+{
+    if (buffer == NULL) return ARROW_OUTPUT_BAD_ARGS;
+
+    flatbuffer_builder builder = {0};
+
+    const size_t header = EncodeMessage (&builder, ARROW_HEADER_SCHEMA, 0);
+
+    flatbuffer_field schema_fields[] = {{1, 4, NULL, 0}};
+    FlatbufferPatch (&builder, header,
+                     FlatbufferTable (&builder, schema_fields, 1));
+
+    const size_t fields_vector =
+        FlatbufferOffsetVector (&builder, ARROW_COLUMNS_NUMBER);
+    FlatbufferPatch (&builder, schema_fields[0].position, fields_vector);
+
+    for (size_t i = 0; i < ARROW_COLUMNS_NUMBER; i++)
+    {
+        const arrow_column* column = &ARROW_COLUMNS[i];
+
+        flatbuffer_field fields[] =
+        {
+            {0, 4, NULL,               0},
+            {1, 1, &column->nullable,  0},
+            {2, 1, &column->type_type, 0},
+            {3, 4, NULL,               0},
+            {5, 4, NULL,               0}
+        };
+
+        FlatbufferPatch (&builder, fields_vector + 4 + 4 * i,
+                         FlatbufferTable (&builder, fields, 5));
+
+        FlatbufferPatch (&builder, fields[0].position,
+                         FlatbufferString (&builder, column->name));
+
+        size_t type = 0;
+        if (column->type_type == ARROW_TYPE_FLOATING_POINT)
+        {
+            flatbuffer_field type_fields[] =
+                {{0, 2, &ARROW_PRECISION_DOUBLE, 0}};
+            type = FlatbufferTable (&builder, type_fields, 1);
+        }
+
+        else
+        {
+            const int32_t bit_width = 8;
+            const bool    is_signed = true;
+
+            flatbuffer_field type_fields[] =
+                {{0, 4, &bit_width, 0}, {1, 1, &is_signed, 0}};
+            type = FlatbufferTable (&builder, type_fields, 2);
+        }
+
+        FlatbufferPatch (&builder, fields[3].position, type);
+        FlatbufferPatch (&builder, fields[4].position,
+                         FlatbufferOffsetVector (&builder, 0));
+    }
+
+    return AppendMessage (buffer, &builder, 0);
+}
+
+
+arrow_output_status
+ArrowEncodeRecordBatch (arrow_buffer*                   buffer,
+                        const quadratic_equation_batch* batch)
+{
+    if (buffer == NULL || batch == NULL) return ARROW_OUTPUT_BAD_ARGS;
+    if (batch->size != 0 &&
+        (batch->x1 == NULL || batch->x2 == NULL ||
+         batch->roots_number == NULL))
+        return ARROW_OUTPUT_BAD_ARGS;
+
+    const size_t rows = batch->size;
+
+    const size_t lengths[ARROW_BUFFERS_NUMBER] =
+    {
+        (rows + 7) / 8, rows * sizeof (double),
+        (rows + 7) / 8, rows * sizeof (double),
+        0,              rows * sizeof (int8_t)
+    };
+
+    int64_t buffers[2 * ARROW_BUFFERS_NUMBER] = {0};
+    size_t  body_length = 0;
+
+    for (size_t i = 0; i < ARROW_BUFFERS_NUMBER; i++)
+    {
+        buffers[2 * i]     = (int64_t) body_length;
+        buffers[2 * i + 1] = (int64_t) lengths[i];
+        body_length += AlignSize (lengths[i], ARROW_ALIGNMENT);
+    }
+
+    int64_t nodes[2 * ARROW_COLUMNS_NUMBER] =
+    {
+        (int64_t) rows, 0,
+        (int64_t) rows, 0,
+        (int64_t) rows, 0
+    };
+
+    flatbuffer_builder builder = {0};
+    EncodeRecordBatchMetadata (&builder, rows, nodes, buffers, body_length);
+
+    const size_t metadata_length =
+        2 * sizeof (uint32_t) + AlignSize (builder.bytes.size, ARROW_ALIGNMENT);
+    ArrowBufferDestructor (&builder.bytes);
+
+    if (builder.failed ||
+        !ReserveBytes (buffer, metadata_length + body_length))
+        return ARROW_OUTPUT_ALLOC_ERROR;
+
+    uint8_t* body = buffer->data + buffer->size + metadata_length;
+    memset (body, 0, body_length);
+
+    nodes[1] = (int64_t) EncodeRootsColumn (batch->x1, rows, body + buffers[0],
+                                                             body + buffers[2]);
+    nodes[3] = (int64_t) EncodeRootsColumn (batch->x2, rows, body + buffers[4],
+                                                             body + buffers[6]);
+
+    int8_t* roots_number = (int8_t*) (body + buffers[10]);
+    for (size_t i = 0; i < rows; i++)
+        roots_number[i] = (int8_t) batch->roots_number[i];
+
+    EncodeRecordBatchMetadata (&builder, rows, nodes, buffers, body_length);
+
+    arrow_output_status status = AppendMessage (buffer, &builder, body_length);
+    if (status == ARROW_OUTPUT_SUCCESS) buffer->size += body_length;
+
+    return status;
+}
+
+
+arrow_output_status
+ArrowEncodeEndOfStream (arrow_buffer* buffer)
+{
+    if (buffer == NULL) return ARROW_OUTPUT_BAD_ARGS;
+
+    const uint32_t end_of_stream[2] = {ARROW_CONTINUATION, 0};
+
+    if (!ReserveBytes (buffer, sizeof (end_of_stream)))
+        return ARROW_OUTPUT_ALLOC_ERROR;
+
+    memcpy (buffer->data + buffer->size, end_of_stream, sizeof (end_of_stream));
+    buffer->size += sizeof (end_of_stream);
+
+    return ARROW_OUTPUT_SUCCESS;
+}
+
+
+arrow_output_status
+ArrowWriteBatch (FILE*                           output,
+                 const quadratic_equation_batch* batch)
+{
+    if (output == NULL || batch == NULL) return ARROW_OUTPUT_BAD_ARGS;
+
+    arrow_buffer buffer = {0};
+    arrow_output_status status = ArrowEncodeSchema (&buffer);
+
+    for (size_t first_row = 0;
+         status == ARROW_OUTPUT_SUCCESS && first_row < batch->size;
+         first_row += ARROW_MAX_BATCH_ROWS)
+    {
+        if (fwrite (buffer.data, 1, buffer.size, output) != buffer.size)
+            status = ARROW_OUTPUT_IO_ERROR;
+        buffer.size = 0;
+
+        quadratic_equation_batch slice = *batch;
+        slice.size = (batch->size - first_row < ARROW_MAX_BATCH_ROWS) ?
+                      batch->size - first_row : ARROW_MAX_BATCH_ROWS;
+        slice.x1           += first_row;
+        slice.x2           += first_row;
+        slice.roots_number += first_row;
+
+        if (status == ARROW_OUTPUT_SUCCESS)
+            status = ArrowEncodeRecordBatch (&buffer, &slice);
+    }
+
+    if (status == ARROW_OUTPUT_SUCCESS)
+        status = ArrowEncodeEndOfStream (&buffer);
+
+    if (status == ARROW_OUTPUT_SUCCESS &&
+        fwrite (buffer.data, 1, buffer.size, output) != buffer.size)
+        status = ARROW_OUTPUT_IO_ERROR;
+
+    ArrowBufferDestructor (&buffer);
+
+    return status;
+}
+
+
+void
+ArrowBufferDestructor (arrow_buffer* buffer)
+{
+    if (buffer == NULL) return;
+
+    free (buffer->data);
+
+    buffer->data     = NULL;
+    buffer->size     = 0;
+    buffer->capacity = 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static bool
+ReserveBytes (arrow_buffer* buffer,
+              size_t        extra)
+{
+    if (buffer->capacity - buffer->size >= extra) return true;
+
+    size_t capacity = 2 * buffer->capacity;
+    if (capacity < buffer->size + extra) capacity = buffer->size + extra;
+
+    uint8_t* data = realloc (buffer->data, capacity);
+    if (data == NULL) return false;
+
+    buffer->data     = data;
+    buffer->capacity = capacity;
+
+    return true;
+}
+
+
+static size_t
+FlatbufferAppend (flatbuffer_builder* builder,
+                  const void*         bytes,
+                  size_t              size)
+{
+    if (builder->failed || !ReserveBytes (&builder->bytes, size))
+    {
+        builder->failed = true;
+        return 0;
+    }
+
+    const size_t position = builder->bytes.size;
+
+    if (bytes != NULL) memcpy (builder->bytes.data + position, bytes, size);
+    else               memset (builder->bytes.data + position, 0,     size);
+
+    builder->bytes.size += size;
+
+    return position;
+}
+
+
+static void
+FlatbufferAlign (flatbuffer_builder* builder,
+                 size_t              alignment)
+{
+    const size_t padding =
+        AlignSize (builder->bytes.size, alignment) - builder->bytes.size;
+
+    if (padding != 0) FlatbufferAppend (builder, NULL, padding);
+}
+
+
+static void
+FlatbufferPatch (flatbuffer_builder* builder,
+                 size_t              position,
+                 size_t              target)
+{
+    if (builder->failed) return;
+
+    const uint32_t offset = (uint32_t) (target - position);
+    memcpy (builder->bytes.data + position, &offset, sizeof (offset));
+}
+
+
+static size_t
+FlatbufferTable (flatbuffer_builder* builder,
+                 flatbuffer_field*   fields,
+                 size_t              count)
+{
+    uint16_t vtable[2 + FLATBUFFER_MAX_FIELDS] = {0};
+    size_t   field_offsets[FLATBUFFER_MAX_FIELDS] = {0};
+
+    size_t entries    = 0;
+    size_t table_size = sizeof (int32_t);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        table_size       = AlignSize (table_size, fields[i].size);
+        field_offsets[i] = table_size;
+        table_size      += fields[i].size;
+
+        vtable[2 + fields[i].id] = (uint16_t) field_offsets[i];
+        if (fields[i].id + 1 > entries) entries = fields[i].id + 1;
+    }
+
+    vtable[0] = (uint16_t) ((2 + entries) * sizeof (uint16_t));
+    vtable[1] = (uint16_t) table_size;
+
+    FlatbufferAlign (builder, sizeof (uint16_t));
+    const size_t vtable_position =
+        FlatbufferAppend (builder, vtable, vtable[0]);
+
+    FlatbufferAlign (builder, ARROW_ALIGNMENT);
+    const size_t table_position = builder->bytes.size;
+
+    const int32_t vtable_offset = (int32_t) (table_position - vtable_position);
+    FlatbufferAppend (builder, &vtable_offset, sizeof (vtable_offset));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        FlatbufferAppend (builder, NULL, table_position + field_offsets[i] -
+                                         builder->bytes.size);
+        fields[i].position =
+            FlatbufferAppend (builder, fields[i].value, fields[i].size);
+    }
+
+    return table_position;
+}
+
+
+static size_t
+FlatbufferStructVector (flatbuffer_builder* builder,
+                        const void*         elements,
+                        size_t              count,
+                        size_t              element_size)
+{
+    const uint32_t length = (uint32_t) count;
+
+    FlatbufferAlign (builder, sizeof (uint32_t));
+    if ((builder->bytes.size + sizeof (length)) % ARROW_ALIGNMENT != 0)
+        FlatbufferAppend (builder, NULL, sizeof (uint32_t));
+
+    const size_t position = FlatbufferAppend (builder, &length, sizeof (length));
+    FlatbufferAppend (builder, elements, count * element_size);
+
+    return position;
+}
+
+
+static size_t
+FlatbufferOffsetVector (flatbuffer_builder* builder,
+                        size_t              count)
+{
+    const uint32_t length = (uint32_t) count;
+
+    FlatbufferAlign (builder, sizeof (uint32_t));
+    const size_t position = FlatbufferAppend (builder, &length, sizeof (length));
+    FlatbufferAppend (builder, NULL, count * sizeof (uint32_t));
+
+    return position;
+}
+
+
+static size_t
+FlatbufferString (flatbuffer_builder* builder,
+                  const char*         string)
+{
+    const uint32_t length = (uint32_t) strlen (string);
+
+    FlatbufferAlign (builder, sizeof (uint32_t));
+    const size_t position = FlatbufferAppend (builder, &length, sizeof (length));
+    FlatbufferAppend (builder, string, length + 1);
+
+    return position;
+}
+
+
+static size_t
+EncodeMessage (flatbuffer_builder* builder,
+               uint8_t             header_type,
+               int64_t             body_length)
+{
+    const size_t root = FlatbufferAppend (builder, NULL, sizeof (uint32_t));
+
+    flatbuffer_field fields[] =
+    {
+        {0, 2, &ARROW_METADATA_VERSION, 0},
+        {1, 1, &header_type,            0},
+        {2, 4, NULL,                    0},
+        {3, 8, &body_length,            0}
+    };
+
+    FlatbufferPatch (builder, root, FlatbufferTable (builder, fields, 4));
+
+    return fields[2].position;
+}
+
+
+static void
+EncodeRecordBatchMetadata (flatbuffer_builder* builder,
+                           size_t              rows,
+                           const int64_t*      nodes,
+                           const int64_t*      buffers,
+                           size_t              body_length)
+{
+    const size_t header = EncodeMessage (builder, ARROW_HEADER_RECORD_BATCH,
+                                         (int64_t) body_length);
+
+    const int64_t length = (int64_t) rows;
+    flatbuffer_field fields[] =
+    {
+        {0, 8, &length, 0},
+        {1, 4, NULL,    0},
+        {2, 4, NULL,    0}
+    };
+
+    FlatbufferPatch (builder, header, FlatbufferTable (builder, fields, 3));
+
+    FlatbufferPatch (builder, fields[1].position,
+                     FlatbufferStructVector (builder, nodes,
+                                             ARROW_COLUMNS_NUMBER,
+                                             2 * sizeof (int64_t)));
+    FlatbufferPatch (builder, fields[2].position,
+                     FlatbufferStructVector (builder, buffers,
+                                             ARROW_BUFFERS_NUMBER,
+                                             2 * sizeof (int64_t)));
+}
+
+
+static arrow_output_status
+AppendMessage (arrow_buffer*       buffer,
+               flatbuffer_builder* builder,
+               size_t              body_length)
+{
+    if (builder->failed)
+    {
+        ArrowBufferDestructor (&builder->bytes);
+        return ARROW_OUTPUT_ALLOC_ERROR;
+    }
+
+    const uint32_t metadata_size =
+        (uint32_t) AlignSize (builder->bytes.size, ARROW_ALIGNMENT);
+    const uint32_t prefix[2] = {ARROW_CONTINUATION, metadata_size};
+
+    if (!ReserveBytes (buffer, sizeof (prefix) + metadata_size + body_length))
+    {
+        ArrowBufferDestructor (&builder->bytes);
+        return ARROW_OUTPUT_ALLOC_ERROR;
+    }
+
+    uint8_t* message = buffer->data + buffer->size;
+
+    memcpy (message, prefix, sizeof (prefix));
+    memcpy (message + sizeof (prefix), builder->bytes.data, builder->bytes.size);
+    memset (message + sizeof (prefix) + builder->bytes.size, 0,
+            metadata_size - builder->bytes.size);
+
+    buffer->size += sizeof (prefix) + metadata_size;
+
+    ArrowBufferDestructor (&builder->bytes);
+
+    return ARROW_OUTPUT_SUCCESS;
+}
+
+
+static size_t
+EncodeRootsColumn (const double* roots,
+                   size_t        rows,
+                   uint8_t*      bitmap,
+                   uint8_t*      values)
+{
+    double* output = (double*) values;
+    size_t  valid  = 0;
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        const int is_valid = !isnan (roots[i]);
+
+        output[i] = is_valid ? roots[i] : 0.0;
+        bitmap[i / 8] |= (uint8_t) (is_valid << (i % 8));
+        valid += (size_t) is_valid;
+    }
+
+    return rows - valid;
+}
+
+
+static inline size_t
+AlignSize (size_t size,
+           size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,1300 @@
+/**
+ * @file csv_ingest.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Delimited (CSV/TSV) files solver implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "csv_ingest.h"
+
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Default input bytes between checkpoints
+static const size_t CSV_DEFAULT_CHECKPOINT_INTERVAL = 1 << 28;
+
+/// @brief The first word of the checkpoint file
+static const char* const CSV_CHECKPOINT_SIGNATURE = "quadratic_checkpoint";
+
+/// @brief Version of the checkpoint file
+static const int CSV_CHECKPOINT_VERSION = 1;
+
+/// @brief Suffix of the temporary checkpoint file
+static const char* const CSV_CHECKPOINT_TMP_SUFFIX = ".tmp";
+
+/// @brief Output format of the checkpoint for Arrow output (text uses the delimiter)
+static const int CSV_CHECKPOINT_ARROW_FORMAT = -1;
+
+/// @brief Size of the input window read at once
+static const size_t CSV_WINDOW_SIZE = 1 << 24;
+
+/// @brief Minimal size of the chunk given to a thread
+static const size_t CSV_MIN_CHUNK_SIZE = 1 << 16;
+
+/// @brief Length of a number copied to the stack for strtod(),
+/// longer numbers are copied to the heap
+static const size_t CSV_STACK_NUMBER_LENGTH = 64;
+
+/// @brief Output size reserved per row besides the key
+static const size_t CSV_OUTPUT_ROW_SIZE = 64;
+
+/// @brief Exactly representable powers of ten
+static const double CSV_POWERS_OF_TEN[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// @brief Maximal exponent of the exact powers of ten
+static const int CSV_MAX_EXACT_POWER = 22;
+
+/// @brief Maximal exactly representable mantissa
+static const uint64_t CSV_MAX_EXACT_MANTISSA = 1ULL << 53;
+
+/// @brief Name of the key column without header row
+static const char* const CSV_DEFAULT_KEY_NAME = "key";
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Resolved 0-based column indices
+ */
+typedef
+struct csv_columns
+{
+    size_t a;       ///< Index of a column
+    size_t b;       ///< Index of b column
+    size_t c;       ///< Index of c column
+    size_t key;     ///< Index of key column
+    bool   has_key; ///< Key column is selected
+    size_t last;    ///< The last index to parse in a line
+}
+csv_columns;
+
+
+/**
+ * @brief Growing character buffer
+ */
+typedef
+struct csv_buffer
+{
+    char*  data;        ///< Characters
+    size_t size;        ///< Number of used characters
+    size_t capacity;    ///< Number of allocated characters
+}
+csv_buffer;
+
+
+/**
+ * @brief Part of the input window processed by one thread
+ */
+typedef
+struct csv_chunk
+{
+    const char*               begin;        ///< First character of the chunk
+    const char*               end;          ///< Past the last character
+    const csv_columns*        columns;      ///< Resolved columns
+    const csv_ingest_options* options;      ///< Solver options
+    csv_buffer                output;       ///< Formatted output lines
+    arrow_buffer              arrow_output; ///< Encoded record batch
+    size_t                    rows_number;  ///< Number of solved rows
+    csv_ingest_status         status;       ///< Result of the chunk
+}
+csv_chunk;
+
+
+/**
+ * @brief Committed progress of the stream
+ */
+typedef
+struct csv_checkpoint
+{
+    int      output_format;     ///< Delimiter or CSV_CHECKPOINT_ARROW_FORMAT
+    uint64_t input_offset;      ///< Offset of the first not processed input byte
+    uint64_t output_offset;     ///< Offset past the last committed output byte
+    uint64_t rows_number;       ///< Number of solved rows before input_offset
+}
+csv_checkpoint;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Finds the end of the field
+ *
+ * @param begin     First character of the field
+ * @param end       Past the last character of the line
+ * @param delimiter Fields delimiter
+ *
+ * @retval Pointer to the delimiter after the field or end
+ *
+ * @details Delimiters inside quotes are skipped
+ */
+static const char*
+FindFieldEnd (const char* begin,
+              const char* end,
+              char        delimiter);
+
+
+/**
+ * @brief Removes surrounding spaces and quotes of the field
+ *
+ * @param begin Pointer to the first character, updated
+ * @param end   Pointer past the last character, updated
+ */
+static void
+TrimField (const char** begin,
+           const char** end);
+
+
+/**
+ * @brief Resolves column selector to 0-based index
+ *
+ * @param selector     Column name or 1-based index
+ * @param header_begin First character of the header line, NULL if none
+ * @param header_end   Past the last character of the header line
+ * @param delimiter    Fields delimiter
+ * @param index        Pointer to the resolved index
+ *
+ * @retval CSV_INGEST_SUCCESS or CSV_INGEST_BAD_COLUMN
+ */
+static csv_ingest_status
+ResolveColumn (const char* selector,
+               const char* header_begin,
+               const char* header_end,
+               char        delimiter,
+               size_t*     index);
+
+
+/**
+ * @brief Resolves all selectors of the options
+ *
+ * @retval CSV_INGEST_SUCCESS or CSV_INGEST_BAD_COLUMN
+ */
+static csv_ingest_status
+ResolveColumns (const csv_ingest_options* options,
+                const char*               header_begin,
+                const char*               header_end,
+                csv_columns*              columns);
+
+
+/**
+ * @brief Writes the output header line
+ *
+ * @retval CSV_INGEST_SUCCESS or CSV_INGEST_IO_ERROR
+ *
+ * @details The key column name is written as it is matched by selectors:
+ * without surrounding spaces and quotes, unless the quotes are needed
+ * because the name holds the delimiter or a quote
+ */
+static csv_ingest_status
+WriteHeader (FILE*                     output,
+             const csv_ingest_options* options,
+             const csv_columns*        columns,
+             const char*               header_begin,
+             const char*               header_end);
+
+
+/**
+ * @brief Parses, solves and formats one chunk
+ *
+ * @param chunk_ptr Pointer to csv_chunk
+ *
+ * @retval NULL
+ *
+ * @details Thread routine, the result is stored in the chunk
+ */
+static void*
+ProcessChunk (void* chunk_ptr);
+
+
+/**
+ * @brief Formats solved rows of the chunk as text lines
+ *
+ * @param chunk       Pointer to the chunk, output is appended
+ * @param batch       Pointer to the solved batch of the chunk
+ * @param keys        Key fields of the rows
+ * @param key_lengths Lengths of the key fields
+ *
+ * @retval CSV_INGEST_SUCCESS or CSV_INGEST_ALLOC_ERROR
+ */
+static csv_ingest_status
+FormatRows (csv_chunk*                      chunk,
+            const quadratic_equation_batch* batch,
+            const char* const*              keys,
+            const size_t*                   key_lengths);
+
+
+/**
+ * @brief Processes complete lines of the input window
+ *
+ * @param begin       First character of the lines
+ * @param end         Past the last line
+ * @param output      Output stream
+ * @param options     Solver options
+ * @param columns     Resolved columns
+ * @param threads     Maximal number of threads
+ * @param rows_number Pointer to the number of solved rows, incremented
+ *
+ * @retval Status @see csv_ingest_status
+ */
+static csv_ingest_status
+ProcessWindow (const char*               begin,
+               const char*               end,
+               FILE*                     output,
+               const csv_ingest_options* options,
+               const csv_columns*        columns,
+               size_t                    threads,
+               size_t*                   rows_number);
+
+
+/**
+ * @brief Prepares the streams for checkpointing
+ *
+ * @param input      Input  stream at its start
+ * @param output     Output stream at its start
+ * @param options    Solver options with checkpoint_path
+ * @param checkpoint Pointer to the checkpoint, filled
+ * @param is_resumed Pointer to the flag, set if the checkpoint is restored
+ *
+ * @retval CSV_INGEST_SUCCESS or CSV_INGEST_CHECKPOINT_ERROR
+ *
+ * @details With resume and an existing checkpoint file the output is
+ * truncated to and positioned at the checkpointed offset,
+ * otherwise the checkpoint holds the streams start offsets
+ * and the output is truncated to its start
+ */
+static csv_ingest_status
+OpenCheckpoint (FILE*                     input,
+                FILE*                     output,
+                const csv_ingest_options* options,
+                csv_checkpoint*           checkpoint,
+                bool*                     is_resumed);
+
+
+/**
+ * @brief Reads the checkpoint file
+ *
+ * @param path       Path to the checkpoint file
+ * @param checkpoint Pointer to the checkpoint, filled
+ * @param is_found   Pointer to the flag, set if the file exists
+ *
+ * @retval CSV_INGEST_SUCCESS or CSV_INGEST_CHECKPOINT_ERROR
+ */
+static csv_ingest_status
+ReadCheckpoint (const char*     path,
+                csv_checkpoint* checkpoint,
+                bool*           is_found);
+
+
+/**
+ * @brief Makes the output durable and atomically replaces the checkpoint
+ *
+ * @param output     Output stream
+ * @param path       Path to the checkpoint file
+ * @param checkpoint Pointer to the checkpoint, output_offset is set
+ *
+ * @retval CSV_INGEST_SUCCESS, CSV_INGEST_ALLOC_ERROR,
+ * CSV_INGEST_IO_ERROR or CSV_INGEST_CHECKPOINT_ERROR
+ *
+ * @details The output is synced before the checkpoint is written
+ * to a temporary file, synced and renamed over the old one,
+ * then the directory is synced to make the rename durable
+ */
+static csv_ingest_status
+CommitCheckpoint (FILE*           output,
+                  const char*     path,
+                  csv_checkpoint* checkpoint);
+
+
+/**
+ * @brief Fills the window from the input
+ *
+ * @param input  Input stream
+ * @param window Pointer to the window buffer
+ * @param is_eof Pointer to the end of file flag, set on end of file
+ *
+ * @retval CSV_INGEST_SUCCESS or CSV_INGEST_IO_ERROR
+ */
+static csv_ingest_status
+FillWindow (FILE*       input,
+            csv_buffer* window,
+            bool*       is_eof);
+
+
+/**
+ * @brief Reserves space in the buffer
+ *
+ * @retval true upon success, false if allocation error occured
+ */
+static bool
+ReserveBuffer (csv_buffer* buffer,
+               size_t      capacity);
+
+
+/**
+ * @brief Appends the double to the buffer, NaN as an empty string
+ *
+ * @details The buffer must have enough space reserved
+ */
+static inline void
+AppendRoot (csv_buffer* buffer,
+            double      root);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Delimited files solver interface implementation
+//------------------------------------------------------------------------------
+
+void
+CsvIngestOptionsInit (csv_ingest_options* options)
+{
+    if (options == NULL) return;
+
+    options->delimiter  = ',';
+    options->has_header = true;
+    options->a_column   = "a";
+    options->b_column   = "b";
+    options->c_column   = "c";
+    options->key_column = NULL;
+    options->threads    = 0;
+
+    options->arrow_output        = false;
+    options->checkpoint_path     = NULL;
+    options->checkpoint_interval = CSV_DEFAULT_CHECKPOINT_INTERVAL;
+    options->resume              = false;
+
+    BatchOptionsInit (&options->solve);
+}
+
+
+csv_ingest_status
+CsvSolveStream (FILE*                     input,
+                FILE*                     output,
+                const csv_ingest_options* options,
+                size_t*                   rows_number)
+{
+    if (input == NULL || output == NULL) return CSV_INGEST_BAD_ARGS;
+
+    csv_ingest_options default_options = {0};
+    if (options == NULL)
+    {
+        CsvIngestOptionsInit (&default_options);
+        options = &default_options;
+    }
+
+    if (options->a_column == NULL || options->b_column == NULL ||
+        options->c_column == NULL)
+        return CSV_INGEST_BAD_ARGS;
+
+    if (!BatchOptionsAreValid (&options->solve)) return CSV_INGEST_BAD_ARGS;
+
+    if (options->resume && options->checkpoint_path == NULL)
+        return CSV_INGEST_BAD_ARGS;
+
+    size_t threads = options->threads;
+    if (threads == 0)
+    {
+        long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (size_t) cpus : 1;
+    }
+
+    csv_buffer window = {0};
+    if (!ReserveBuffer (&window, CSV_WINDOW_SIZE))
+        return CSV_INGEST_ALLOC_ERROR;
+
+    csv_ingest_status status = CSV_INGEST_SUCCESS;
+    csv_columns columns = {0};
+    bool   is_eof        = false;
+    size_t solved_rows   = 0;
+    size_t header_length = 0;
+
+    csv_checkpoint checkpoint = {0};
+    bool is_resumed = false;
+    if (options->checkpoint_path != NULL)
+        status = OpenCheckpoint (input, output, options,
+                                 &checkpoint, &is_resumed);
+
+    const char* header_end = NULL;
+    while (status == CSV_INGEST_SUCCESS && options->has_header)
+    {
+        status = FillWindow (input, &window, &is_eof);
+        if (status != CSV_INGEST_SUCCESS) break;
+
+        header_end = memchr (window.data, '\n', window.size);
+        if (header_end != NULL || is_eof) break;
+
+        if (!ReserveBuffer (&window, 2 * window.capacity))
+        {
+            status = CSV_INGEST_ALLOC_ERROR;
+            break;
+        }
+    }
+
+    if (status == CSV_INGEST_SUCCESS)
+    {
+        if (options->has_header)
+        {
+            if (header_end == NULL) header_end = window.data + window.size;
+            header_length = (size_t) (header_end - window.data);
+
+            const char* line_end = header_end;
+            if (line_end > window.data && line_end[-1] == '\r') line_end--;
+
+            status = ResolveColumns (options, window.data, line_end, &columns);
+            if (status == CSV_INGEST_SUCCESS && !is_resumed)
+                status = WriteHeader (output, options, &columns,
+                                      window.data, line_end);
+
+            if (header_length < window.size) header_length++;
+            memmove (window.data, window.data + header_length,
+                     window.size - header_length);
+            window.size -= header_length;
+        }
+
+        else
+        {
+            status = ResolveColumns (options, NULL, NULL, &columns);
+            if (status == CSV_INGEST_SUCCESS && !is_resumed)
+                status = WriteHeader (output, options, &columns, NULL, NULL);
+        }
+    }
+
+    if (status == CSV_INGEST_SUCCESS && is_resumed)
+    {
+        if (fseeko (input, (off_t) checkpoint.input_offset, SEEK_SET) != 0)
+            status = CSV_INGEST_CHECKPOINT_ERROR;
+
+        window.size = 0;
+        is_eof      = false;
+        solved_rows = checkpoint.rows_number;
+    }
+
+    else checkpoint.input_offset += header_length;
+
+    uint64_t committed_offset = checkpoint.input_offset;
+
+    while (status == CSV_INGEST_SUCCESS)
+    {
+        if (!is_eof)
+        {
+            status = FillWindow (input, &window, &is_eof);
+            if (status != CSV_INGEST_SUCCESS) break;
+        }
+
+        size_t ready = window.size;
+        if (!is_eof)
+        {
+            while (ready > 0 && window.data[ready - 1] != '\n') ready--;
+        }
+
+        if (ready == 0)
+        {
+            if (is_eof) break;
+
+            if (window.size == window.capacity &&
+                !ReserveBuffer (&window, 2 * window.capacity))
+                status = CSV_INGEST_ALLOC_ERROR;
+
+            continue;
+        }
+
+        status = ProcessWindow (window.data, window.data + ready, output,
+                                options, &columns, threads, &solved_rows);
+
+        memmove (window.data, window.data + ready, window.size - ready);
+        window.size -= ready;
+
+        checkpoint.input_offset += ready;
+
+        if (status == CSV_INGEST_SUCCESS && options->checkpoint_path != NULL &&
+            checkpoint.input_offset - committed_offset >=
+            options->checkpoint_interval)
+        {
+            checkpoint.rows_number = solved_rows;
+            status = CommitCheckpoint (output, options->checkpoint_path,
+                                       &checkpoint);
+            committed_offset = checkpoint.input_offset;
+        }
+    }
+
+    free (window.data);
+
+    if (status == CSV_INGEST_SUCCESS && options->arrow_output)
+    {
+        arrow_buffer end_of_stream = {0};
+
+        if (ArrowEncodeEndOfStream (&end_of_stream) != ARROW_OUTPUT_SUCCESS)
+            status = CSV_INGEST_ALLOC_ERROR;
+        else if (fwrite (end_of_stream.data, 1, end_of_stream.size, output) !=
+                 end_of_stream.size)
+            status = CSV_INGEST_IO_ERROR;
+
+        ArrowBufferDestructor (&end_of_stream);
+    }
+
+    if (status == CSV_INGEST_SUCCESS && fflush (output) != 0)
+        status = CSV_INGEST_IO_ERROR;
+
+    if (status == CSV_INGEST_SUCCESS && options->checkpoint_path != NULL &&
+        remove (options->checkpoint_path) != 0 && errno != ENOENT)
+        status = CSV_INGEST_CHECKPOINT_ERROR;
+
+    if (rows_number != NULL) *rows_number = solved_rows;
+
+    return status;
+}
+
+
+double
+CsvParseNumber (const char* begin,
+                const char* end)
+{
+    TrimField (&begin, &end);
+    if (begin >= end) return NAN;
+
+    const char* current  = begin;
+    bool        negative = false;
+
+    if (*current == '-' || *current == '+')
+    {
+        negative = (*current == '-');
+        current++;
+    }
+
+    uint64_t mantissa = 0;
+    size_t   digits   = 0;
+    int      exponent = 0;
+    bool     is_fast  = true;
+
+    for (; current < end && *current >= '0' && *current <= '9'; current++)
+    {
+        if (mantissa > (UINT64_MAX - 9) / 10) is_fast = false;
+        else mantissa = mantissa * 10 + (uint64_t) (*current - '0');
+        digits++;
+    }
+
+    if (current < end && *current == '.')
+    {
+        for (current++; current < end && *current >= '0' && *current <= '9';
+                        current++)
+        {
+            if (mantissa > (UINT64_MAX - 9) / 10) is_fast = false;
+            else mantissa = mantissa * 10 + (uint64_t) (*current - '0');
+            exponent--;
+            digits++;
+        }
+    }
+
+    if (digits == 0) is_fast = false;
+
+    if (current < end && (*current == 'e' || *current == 'E'))
+    {
+        current++;
+
+        bool exponent_negative = false;
+        if (current < end && (*current == '-' || *current == '+'))
+        {
+            exponent_negative = (*current == '-');
+            current++;
+        }
+
+        int written_exponent = 0;
+        if (current == end || *current < '0' || *current > '9')
+            is_fast = false;
+
+        for (; current < end && *current >= '0' && *current <= '9'; current++)
+            if (written_exponent < 10000)
+                written_exponent = written_exponent * 10 + (*current - '0');
+
+        exponent += exponent_negative ? -written_exponent : written_exponent;
+    }
+
+    if (is_fast && current == end && mantissa <= CSV_MAX_EXACT_MANTISSA &&
+        exponent >= -CSV_MAX_EXACT_POWER && exponent <= CSV_MAX_EXACT_POWER)
+    {
+        double value = (double) mantissa;
+        value = (exponent < 0) ? value / CSV_POWERS_OF_TEN[-exponent] :
+                                 value * CSV_POWERS_OF_TEN[ exponent];
+
+        return negative ? -value : value;
+    }
+
+    const size_t length = (size_t) (end - begin);
+
+    char  stack_number[CSV_STACK_NUMBER_LENGTH];
+    char* number = stack_number;
+
+    if (length >= CSV_STACK_NUMBER_LENGTH)
+    {
+        number = malloc (length + 1);
+        if (number == NULL) return NAN;
+    }
+
+    memcpy (number, begin, length);
+    number[length] = '\0';
+
+    char* number_end = NULL;
+    double value = strtod (number, &number_end);
+    if (number_end != number + length) value = NAN;
+
+    if (number != stack_number) free (number);
+
+    return value;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static const char*
+FindFieldEnd (const char* begin,
+              const char* end,
+              char        delimiter)
+{
+    const char* current = begin;
+
+    while (current < end && *current == ' ') current++;
+
+    if (current < end && *current == '"')
+    {
+        for (current++; current < end; current++)
+        {
+            if (*current != '"') continue;
+            if (current + 1 < end && current[1] == '"') current++;
+            else break;
+        }
+
+        if (current < end) current++;
+    }
+
+    else current = begin;
+
+    const char* field_end = memchr (current, delimiter, (size_t) (end - current));
+    return (field_end != NULL) ? field_end : end;
+}
+
+
+static void
+TrimField (const char** begin,
+           const char** end)
+{
+    while (*begin < *end && ((*begin)[0] == ' ' || (*begin)[0] == '\t'))
+        (*begin)++;
+    while (*begin < *end && ((*end)[-1] == ' ' || (*end)[-1] == '\t'))
+        (*end)--;
+
+    if (*end - *begin >= 2 && (*begin)[0] == '"' && (*end)[-1] == '"')
+    {
+        (*begin)++;
+        (*end)--;
+    }
+}
+
+
+static csv_ingest_status
+ResolveColumn (const char* selector,
+               const char* header_begin,
+               const char* header_end,
+               char        delimiter,
+               size_t*     index)
+{
+    const size_t selector_length = strlen (selector);
+
+    if (selector_length > 0 &&
+        strspn (selector, "0123456789") == selector_length)
+    {
+        unsigned long number = strtoul (selector, NULL, 10);
+        if (number == 0) return CSV_INGEST_BAD_COLUMN;
+
+        *index = (size_t) number - 1;
+        return CSV_INGEST_SUCCESS;
+    }
+
+    if (header_begin == NULL) return CSV_INGEST_BAD_COLUMN;
+
+    const char* field = header_begin;
+    for (size_t column = 0; field <= header_end; column++)
+    {
+        const char* field_end = FindFieldEnd (field, header_end, delimiter);
+
+        const char* name     = field;
+        const char* name_end = field_end;
+        TrimField (&name, &name_end);
+
+        if ((size_t) (name_end - name) == selector_length &&
+            memcmp (name, selector, selector_length) == 0)
+        {
+            *index = column;
+            return CSV_INGEST_SUCCESS;
+        }
+
+        field = field_end + 1;
+    }
+
+    return CSV_INGEST_BAD_COLUMN;
+}
+
+
+static csv_ingest_status
+ResolveColumns (const csv_ingest_options* options,
+                const char*               header_begin,
+                const char*               header_end,
+                csv_columns*              columns)
+{
+    const char delimiter = options->delimiter;
+    csv_ingest_status status = CSV_INGEST_SUCCESS;
+
+    status = ResolveColumn (options->a_column, header_begin, header_end,
+                            delimiter, &columns->a);
+    if (status != CSV_INGEST_SUCCESS) return status;
+
+    status = ResolveColumn (options->b_column, header_begin, header_end,
+                            delimiter, &columns->b);
+    if (status != CSV_INGEST_SUCCESS) return status;
+
+    status = ResolveColumn (options->c_column, header_begin, header_end,
+                            delimiter, &columns->c);
+    if (status != CSV_INGEST_SUCCESS) return status;
+
+    columns->has_key = (options->key_column != NULL);
+    if (columns->has_key)
+    {
+        status = ResolveColumn (options->key_column, header_begin, header_end,
+                                delimiter, &columns->key);
+        if (status != CSV_INGEST_SUCCESS) return status;
+    }
+
+    columns->last = columns->a;
+    if (columns->b > columns->last) columns->last = columns->b;
+    if (columns->c > columns->last) columns->last = columns->c;
+    if (columns->has_key && columns->key > columns->last)
+        columns->last = columns->key;
+
+    return CSV_INGEST_SUCCESS;
+}
+
+
+static csv_ingest_status
+WriteHeader (FILE*                     output,
+             const csv_ingest_options* options,
+             const csv_columns*        columns,
+             const char*               header_begin,
+             const char*               header_end)
+{
+    const char delimiter = options->delimiter;
+
+    if (options->arrow_output)
+    {
+        arrow_buffer schema = {0};
+        csv_ingest_status status = CSV_INGEST_SUCCESS;
+
+        if (ArrowEncodeSchema (&schema) != ARROW_OUTPUT_SUCCESS)
+            status = CSV_INGEST_ALLOC_ERROR;
+        else if (fwrite (schema.data, 1, schema.size, output) != schema.size)
+            status = CSV_INGEST_IO_ERROR;
+
+        ArrowBufferDestructor (&schema);
+        return status;
+    }
+
+    if (columns->has_key)
+    {
+        const char* name        = CSV_DEFAULT_KEY_NAME;
+        size_t      name_length = strlen (CSV_DEFAULT_KEY_NAME);
+
+        const char* field = header_begin;
+        for (size_t column = 0; field != NULL && field <= header_end; column++)
+        {
+            const char* field_end = FindFieldEnd (field, header_end, delimiter);
+
+            if (column == columns->key)
+            {
+                const char* name_end = field_end;
+
+                name = field;
+                TrimField (&name, &name_end);
+                name_length = (size_t) (name_end - name);
+
+                const bool is_unquoted = (name != field && name[-1] == '"');
+                if (is_unquoted &&
+                    (memchr (name, delimiter, name_length) != NULL ||
+                     memchr (name, '"',       name_length) != NULL))
+                {
+                    name--;
+                    name_length += 2;
+                }
+
+                break;
+            }
+
+            field = field_end + 1;
+        }
+
+        if (fwrite (name, 1, name_length, output) != name_length ||
+            fputc (delimiter, output) == EOF)
+            return CSV_INGEST_IO_ERROR;
+    }
+
+    if (fprintf (output, "roots_number%cx1%cx2\n", delimiter, delimiter) < 0)
+        return CSV_INGEST_IO_ERROR;
+
+    return CSV_INGEST_SUCCESS;
+}
+
+
+static csv_ingest_status
+FormatRows (csv_chunk*                      chunk,
+            const quadratic_equation_batch* batch,
+            const char* const*              keys,
+            const size_t*                   key_lengths)
+{
+    const bool has_key   = chunk->columns->has_key;
+    const char delimiter = chunk->options->delimiter;
+
+    size_t output_size = batch->size * CSV_OUTPUT_ROW_SIZE;
+    for (size_t i = 0; i < batch->size; i++) output_size += key_lengths[i];
+
+    csv_buffer* output = &chunk->output;
+    if (!ReserveBuffer (output, output_size + 1))
+        return CSV_INGEST_ALLOC_ERROR;
+
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        if (has_key)
+        {
+            if (key_lengths[i] > 0)
+                memcpy (output->data + output->size, keys[i], key_lengths[i]);
+            output->size += key_lengths[i];
+            output->data[output->size++] = delimiter;
+        }
+
+        output->data[output->size++] = (char) ('0' + batch->roots_number[i]);
+        output->data[output->size++] = delimiter;
+        AppendRoot (output, batch->x1[i]);
+        output->data[output->size++] = delimiter;
+        AppendRoot (output, batch->x2[i]);
+        output->data[output->size++] = '\n';
+    }
+
+    return CSV_INGEST_SUCCESS;
+}
+
+
+static void*
+ProcessChunk (void* chunk_ptr)
+{
+    csv_chunk* chunk = chunk_ptr;
+    const csv_columns* columns   = chunk->columns;
+    const char         delimiter = chunk->options->delimiter;
+
+    size_t lines = 0;
+    for (const char* line = chunk->begin; line < chunk->end; lines++)
+    {
+        const char* line_end =
+            memchr (line, '\n', (size_t) (chunk->end - line));
+        line = (line_end != NULL) ? line_end + 1 : chunk->end;
+    }
+
+    quadratic_equation_batch* batch = BatchConstructor (lines);
+    const char** keys        = calloc (lines, sizeof (const char*));
+    size_t*      key_lengths = calloc (lines, sizeof (size_t));
+
+    if (batch == NULL || keys == NULL || key_lengths == NULL)
+    {
+        chunk->status = CSV_INGEST_ALLOC_ERROR;
+        batch = BatchDestructor (batch);
+        free (keys);
+        free (key_lengths);
+        return NULL;
+    }
+
+    size_t rows = 0;
+    for (const char* line = chunk->begin; line < chunk->end;)
+    {
+        const char* line_end =
+            memchr (line, '\n', (size_t) (chunk->end - line));
+        const char* next_line = (line_end != NULL) ? line_end + 1 : chunk->end;
+        if (line_end == NULL) line_end = chunk->end;
+        if (line_end > line && line_end[-1] == '\r') line_end--;
+
+        if (line_end == line)
+        {
+            line = next_line;
+            continue;
+        }
+
+        batch->a[rows] = NAN;
+        batch->b[rows] = NAN;
+        batch->c[rows] = NAN;
+
+        const char* field = line;
+        for (size_t column = 0; column <= columns->last; column++)
+        {
+            const char* field_end = FindFieldEnd (field, line_end, delimiter);
+
+            if (column == columns->a)
+                batch->a[rows] = CsvParseNumber (field, field_end);
+            if (column == columns->b)
+                batch->b[rows] = CsvParseNumber (field, field_end);
+            if (column == columns->c)
+                batch->c[rows] = CsvParseNumber (field, field_end);
+            if (columns->has_key && column == columns->key)
+            {
+                keys       [rows] = field;
+                key_lengths[rows] = (size_t) (field_end - field);
+            }
+
+            if (field_end == line_end) break;
+            field = field_end + 1;
+        }
+
+        rows++;
+        line = next_line;
+    }
+
+    batch->size = rows;
+
+    if (SolveQuadraticBatch (batch, &chunk->options->solve) !=
+        QUADRATIC_BATCH_SUCCESS)
+        chunk->status = CSV_INGEST_ALLOC_ERROR;
+
+    if (chunk->status == CSV_INGEST_SUCCESS)
+    {
+        if (chunk->options->arrow_output)
+        {
+            if (ArrowEncodeRecordBatch (&chunk->arrow_output, batch) !=
+                ARROW_OUTPUT_SUCCESS)
+                chunk->status = CSV_INGEST_ALLOC_ERROR;
+        }
+
+        else chunk->status = FormatRows (chunk, batch, keys, key_lengths);
+    }
+
+    chunk->rows_number = rows;
+
+    batch = BatchDestructor (batch);
+    free (keys);
+    free (key_lengths);
+
+    return NULL;
+}
+
+
+static csv_ingest_status
+ProcessWindow (const char*               begin,
+               const char*               end,
+               FILE*                     output,
+               const csv_ingest_options* options,
+               const csv_columns*        columns,
+               size_t                    threads,
+               size_t*                   rows_number)
+{
+    const size_t size = (size_t) (end - begin);
+
+    size_t chunks_number = size / CSV_MIN_CHUNK_SIZE + 1;
+    if (chunks_number > threads) chunks_number = threads;
+
+    csv_chunk* chunks     = calloc (chunks_number, sizeof (csv_chunk));
+    pthread_t* thread_ids = calloc (chunks_number, sizeof (pthread_t));
+    bool*      started    = calloc (chunks_number, sizeof (bool));
+
+    if (chunks == NULL || thread_ids == NULL || started == NULL)
+    {
+        free (chunks);
+        free (thread_ids);
+        free (started);
+        return CSV_INGEST_ALLOC_ERROR;
+    }
+
+    const char* chunk_begin = begin;
+    for (size_t i = 0; i < chunks_number; i++)
+    {
+        const char* chunk_end = end;
+        if (i + 1 < chunks_number)
+        {
+            chunk_end = begin + size / chunks_number * (i + 1);
+            if (chunk_end < chunk_begin) chunk_end = chunk_begin;
+
+            const char* line_end =
+                memchr (chunk_end, '\n', (size_t) (end - chunk_end));
+            chunk_end = (line_end != NULL) ? line_end + 1 : end;
+        }
+
+        chunks[i].begin   = chunk_begin;
+        chunks[i].end     = chunk_end;
+        chunks[i].columns = columns;
+        chunks[i].options = options;
+        chunks[i].status  = CSV_INGEST_SUCCESS;
+
+        chunk_begin = chunk_end;
+    }
+
+    csv_ingest_status status = CSV_INGEST_SUCCESS;
+
+    for (size_t i = 1; i < chunks_number; i++)
+    {
+        started[i] = (pthread_create (&thread_ids[i], NULL,
+                                      ProcessChunk, &chunks[i]) == 0);
+        if (!started[i]) status = CSV_INGEST_THREAD_ERROR;
+    }
+
+    ProcessChunk (&chunks[0]);
+
+    for (size_t i = 1; i < chunks_number; i++)
+        if (started[i]) pthread_join (thread_ids[i], NULL);
+
+    for (size_t i = 0; i < chunks_number; i++)
+    {
+        if (status == CSV_INGEST_SUCCESS) status = chunks[i].status;
+
+        if (status == CSV_INGEST_SUCCESS && chunks[i].output.size != 0 &&
+            fwrite (chunks[i].output.data, 1, chunks[i].output.size, output) !=
+            chunks[i].output.size)
+            status = CSV_INGEST_IO_ERROR;
+
+        if (status == CSV_INGEST_SUCCESS && chunks[i].arrow_output.size != 0 &&
+            fwrite (chunks[i].arrow_output.data, 1, chunks[i].arrow_output.size,
+                    output) != chunks[i].arrow_output.size)
+            status = CSV_INGEST_IO_ERROR;
+
+        *rows_number += chunks[i].rows_number;
+        free (chunks[i].output.data);
+        ArrowBufferDestructor (&chunks[i].arrow_output);
+    }
+
+    free (chunks);
+    free (thread_ids);
+    free (started);
+
+    return status;
+}
+
+
+static csv_ingest_status
+OpenCheckpoint (FILE*                     input,
+                FILE*                     output,
+                const csv_ingest_options* options,
+                csv_checkpoint*           checkpoint,
+                bool*                     is_resumed)
+{
+    const int output_format = options->arrow_output ?
+                              CSV_CHECKPOINT_ARROW_FORMAT : options->delimiter;
+
+    const off_t input_start  = ftello (input);
+    const off_t output_start = ftello (output);
+    if (input_start < 0 || output_start < 0 || fflush (output) != 0)
+        return CSV_INGEST_CHECKPOINT_ERROR;
+
+    checkpoint->output_format = output_format;
+    checkpoint->input_offset  = (uint64_t) input_start;
+    checkpoint->output_offset = (uint64_t) output_start;
+    checkpoint->rows_number   = 0;
+
+    if (options->resume)
+    {
+        csv_ingest_status status =
+            ReadCheckpoint (options->checkpoint_path, checkpoint, is_resumed);
+        if (status != CSV_INGEST_SUCCESS) return status;
+
+        if (*is_resumed && checkpoint->output_format != output_format)
+            return CSV_INGEST_CHECKPOINT_ERROR;
+    }
+
+    if (ftruncate (fileno (output), (off_t) checkpoint->output_offset) != 0 ||
+        fseeko (output, (off_t) checkpoint->output_offset, SEEK_SET) != 0)
+        return CSV_INGEST_CHECKPOINT_ERROR;
+
+    return CSV_INGEST_SUCCESS;
+}
+
+
+static csv_ingest_status
+ReadCheckpoint (const char*     path,
+                csv_checkpoint* checkpoint,
+                bool*           is_found)
+{
+    FILE* file = fopen (path, "r");
+    if (file == NULL)
+    {
+        *is_found = false;
+        return (errno == ENOENT) ? CSV_INGEST_SUCCESS :
+                                   CSV_INGEST_CHECKPOINT_ERROR;
+    }
+
+    char signature[32] = "";
+    int  version       = 0;
+
+    const int fields_number =
+        fscanf (file, "%31s %d %d %" SCNu64 " %" SCNu64 " %" SCNu64,
+                signature, &version, &checkpoint->output_format,
+                &checkpoint->input_offset, &checkpoint->output_offset,
+                &checkpoint->rows_number);
+
+    fclose (file);
+
+    if (fields_number != 6 ||
+        strcmp (signature, CSV_CHECKPOINT_SIGNATURE) != 0 ||
+        version != CSV_CHECKPOINT_VERSION)
+        return CSV_INGEST_CHECKPOINT_ERROR;
+
+    *is_found = true;
+    return CSV_INGEST_SUCCESS;
+}
+
+
+static csv_ingest_status
+CommitCheckpoint (FILE*           output,
+                  const char*     path,
+                  csv_checkpoint* checkpoint)
+{
+    if (fflush (output) != 0 || fsync (fileno (output)) != 0)
+        return CSV_INGEST_IO_ERROR;
+
+    const off_t output_offset = ftello (output);
+    if (output_offset < 0) return CSV_INGEST_CHECKPOINT_ERROR;
+    checkpoint->output_offset = (uint64_t) output_offset;
+
+    const size_t path_length = strlen (path);
+    char* tmp_path = malloc (path_length + strlen (CSV_CHECKPOINT_TMP_SUFFIX) + 1);
+    if (tmp_path == NULL) return CSV_INGEST_ALLOC_ERROR;
+
+    memcpy (tmp_path, path, path_length);
+    strcpy (tmp_path + path_length, CSV_CHECKPOINT_TMP_SUFFIX);
+
+    csv_ingest_status status = CSV_INGEST_SUCCESS;
+
+    FILE* file = fopen (tmp_path, "w");
+    if (file == NULL) status = CSV_INGEST_CHECKPOINT_ERROR;
+
+    else
+    {
+        if (fprintf (file, "%s %d %d %" PRIu64 " %" PRIu64 " %" PRIu64 "\n",
+                     CSV_CHECKPOINT_SIGNATURE, CSV_CHECKPOINT_VERSION,
+                     checkpoint->output_format, checkpoint->input_offset,
+                     checkpoint->output_offset, checkpoint->rows_number) < 0 ||
+            fflush (file) != 0 || fsync (fileno (file)) != 0)
+            status = CSV_INGEST_CHECKPOINT_ERROR;
+
+        if (fclose (file) != 0) status = CSV_INGEST_CHECKPOINT_ERROR;
+
+        if (status == CSV_INGEST_SUCCESS && rename (tmp_path, path) != 0)
+            status = CSV_INGEST_CHECKPOINT_ERROR;
+    }
+
+    if (status == CSV_INGEST_SUCCESS)
+    {
+        char* directory_end = strrchr (tmp_path, '/');
+
+        if      (directory_end == NULL)     strcpy (tmp_path, ".");
+        else if (directory_end == tmp_path) tmp_path[1]    = '\0';
+        else                                *directory_end = '\0';
+
+        const int directory = open (tmp_path, O_RDONLY | O_DIRECTORY);
+        if (directory >= 0)
+        {
+            fsync (directory);
+            close (directory);
+        }
+    }
+
+    free (tmp_path);
+
+    return status;
+}
+
+
+static csv_ingest_status
+FillWindow (FILE*       input,
+            csv_buffer* window,
+            bool*       is_eof)
+{
+    const size_t free_space = window->capacity - window->size;
+    const size_t read_size  =
+        fread (window->data + window->size, 1, free_space, input);
+
+    window->size += read_size;
+
+    if (read_size < free_space)
+    {
+        if (ferror (input)) return CSV_INGEST_IO_ERROR;
+        *is_eof = true;
+    }
+
+    return CSV_INGEST_SUCCESS;
+}
+
+
+static bool
+ReserveBuffer (csv_buffer* buffer,
+               size_t      capacity)
+{
+    if (buffer->capacity >= capacity) return true;
+
+    char* data = realloc (buffer->data, capacity);
+    if (data == NULL) return false;
+
+    buffer->data     = data;
+    buffer->capacity = capacity;
+
+    return true;
+}
+
+
+static inline void
+AppendRoot (csv_buffer* buffer,
+            double      root)
+{
+    if (isnan (root)) return;
+
+    const int length = snprintf (buffer->data + buffer->size,
+                                 buffer->capacity - buffer->size,
+                                 "%.17g", root);
+    if (length > 0) buffer->size += (size_t) length;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
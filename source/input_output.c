@@ -40,6 +40,12 @@ const char* const OUTPUT_SECOND_ROOT_MESSAGE  = "Second root:";
 const char* const OUTPUT_NO_ROOTS_MESSAGE     = "No roots";
 const char* const OUTPUT_INF_ROOTS_MESSAGE    = "Infinite number of roots";
 
+/// @brief Header of the benchmark report
+const char* const BENCH_HEADER_MESSAGE = "Equations:";
+
+/// @brief Header of the latency benchmark report
+const char* const LATENCY_HEADER_MESSAGE = "Samples:";
+
 /**
  * @brief Enumeration for input read status
  */
@@ -204,6 +210,65 @@ PrintRoots (const quadratic_equation* equation)
     }
 }
 
+
+void
+PrintBenchReport (const quadratic_bench_report* report)
+{
+    if (report == NULL) return;
+
+    printf ("%s %zu, threads: %zu, NUMA nodes: %zu\n", BENCH_HEADER_MESSAGE,
+            report->rows, report->threads, report->nodes_number);
+
+    for (size_t i = 0; i < report->cases_number; i++)
+        PrintBenchResult (stdout, &report->cases[i]);
+}
+
+
+void
+PrintBenchResult (FILE*                         stream,
+                  const quadratic_bench_result* result)
+{
+    if (stream == NULL || result == NULL) return;
+
+    fprintf (stream, "%-24s %10.3f ms %10.1f Meq/s",
+             result->name, result->seconds * 1e3,
+             result->rows_per_second * 1e-6);
+
+    if (result->bytes_per_second > 0)
+        fprintf (stream, " %8.2f GB/s", result->bytes_per_second * 1e-9);
+
+    if (result->speedup > 0)
+        fprintf (stream, " %6.2fx", result->speedup);
+
+    if (result->has_counters)
+        fprintf (stream, " %6.2f IPC %8.4f br-miss/eq "
+                         "%8.4f L1-miss/eq %8.4f LLC-miss/eq",
+                 result->instructions_per_cycle,
+                 result->branch_misses_per_row,
+                 result->l1_misses_per_row,
+                 result->llc_misses_per_row);
+
+    fputc ('\n', stream);
+}
+
+
+void
+PrintLatencyReport (const quadratic_latency_report* report)
+{
+    if (report == NULL) return;
+
+    printf ("%s %zu\n", LATENCY_HEADER_MESSAGE, report->samples);
+
+    for (size_t i = 0; i < report->cases_number; i++)
+    {
+        const quadratic_latency_result* result = &report->cases[i];
+
+        printf ("%-24s p50 %8.0f ns p99 %8.0f ns p99.9 %8.0f ns max %10.0f ns\n",
+                result->name, result->p50_ns, result->p99_ns,
+                result->p999_ns, result->max_ns);
+    }
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 
@@ -0,0 +1,149 @@
+/**
+ * @file perf_counters.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Hardware performance counters implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "perf_counters.h"
+
+
+
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Event of perf_event_open()
+ */
+typedef
+struct perf_event_config
+{
+    uint32_t type;      ///< Event type
+    uint64_t config;    ///< Event config
+}
+perf_event_config;
+
+/// @brief Events in the order of perf_counter_event
+static const perf_event_config PERF_EVENTS[PERF_COUNTER_COUNT] =
+{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                         (PERF_COUNT_HW_CACHE_OP_READ     <<  8) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}
+};
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Performance counters interface implementation
+//------------------------------------------------------------------------------
+
+bool
+PerfCountersOpen (perf_counters* counters)
+{
+    if (counters == NULL) return false;
+
+    bool is_available = false;
+
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        struct perf_event_attr attributes = {0};
+
+        attributes.size           = sizeof (attributes);
+        attributes.type           = PERF_EVENTS[i].type;
+        attributes.config         = PERF_EVENTS[i].config;
+        attributes.disabled       = 1;
+        attributes.inherit        = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+        attributes.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                    PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        counters->fds[i] = (int) syscall (SYS_perf_event_open, &attributes,
+                                          0, -1, -1, 0);
+
+        if (counters->fds[i] >= 0) is_available = true;
+        else                       counters->fds[i] = -1;
+    }
+
+    return is_available;
+}
+
+
+void
+PerfCountersClose (perf_counters* counters)
+{
+    if (counters == NULL) return;
+
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (counters->fds[i] >= 0) close (counters->fds[i]);
+        counters->fds[i] = -1;
+    }
+}
+
+
+void
+PerfCountersStart (perf_counters* counters)
+{
+    if (counters == NULL) return;
+
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (counters->fds[i] < 0) continue;
+
+        ioctl (counters->fds[i], PERF_EVENT_IOC_RESET,  0);
+        ioctl (counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+
+void
+PerfCountersStop (perf_counters*        counters,
+                  perf_counters_values* values)
+{
+    if (counters == NULL || values == NULL) return;
+
+    memset (values, 0, sizeof (perf_counters_values));
+
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (counters->fds[i] < 0) continue;
+
+        ioctl (counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        uint64_t data[3] = {0};   // value, time enabled, time running
+        if (read (counters->fds[i], data, sizeof (data)) != sizeof (data) ||
+            data[2] == 0)
+            continue;
+
+        values->values[i]   = (data[1] == data[2]) ? data[0] :
+            (uint64_t) ((double) data[0] * (double) data[1] / (double) data[2]);
+        values->is_valid[i] = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
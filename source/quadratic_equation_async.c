@@ -0,0 +1,420 @@
+/**
+ * @file quadratic_equation_async.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Worker pool implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "quadratic_equation_async.h"
+
+
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Default size of the coalescing buffer
+static const size_t ASYNC_DEFAULT_COALESCE_ROWS = 4096;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Worker pool
+ */
+struct quadratic_async_pool
+{
+    quadratic_async_options  options;       ///< Pool options
+    pthread_mutex_t          lock;          ///< Guard of the queue and done flags
+    pthread_cond_t           has_work;      ///< Queue is not empty or pool stops
+    pthread_cond_t           has_done;      ///< Some request is done
+    quadratic_async_request* head;          ///< First request in the queue
+    quadratic_async_request* tail;          ///< Last  request in the queue
+    bool                     is_stopping;   ///< Destructor is called
+    size_t                   threads;       ///< Number of started workers
+    pthread_t*               thread_ids;    ///< Workers
+};
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Worker thread routine
+ *
+ * @param pool_ptr Pointer to the pool
+ *
+ * @retval NULL
+ */
+static void*
+RunWorker (void* pool_ptr);
+
+
+/**
+ * @brief Takes the next request or a chain of small ones from the queue
+ *
+ * @param pool Pointer to the locked pool with not empty queue
+ * @param rows Pointer to the total rows number of the chain
+ *
+ * @retval First request of the chain, linked by next
+ */
+static quadratic_async_request*
+PopRequests (quadratic_async_pool* pool,
+             size_t*               rows);
+
+
+/**
+ * @brief Solves a chain of small requests by one call
+ *
+ * @param pool    Pointer to the pool
+ * @param buffer  Worker buffer of coalesce_rows rows
+ * @param chain   First request of the chain
+ * @param rows    Total rows number of the chain
+ *
+ * @retval Status @see quadratic_batch_status
+ */
+static quadratic_batch_status
+SolveCoalesced (const quadratic_async_pool* pool,
+                quadratic_equation_batch*   buffer,
+                quadratic_async_request*    chain,
+                size_t                      rows);
+
+
+/**
+ * @brief Calls the callbacks and marks the requests of the chain done
+ *
+ * @param pool   Pointer to the pool
+ * @param chain  First request of the chain
+ * @param status Status of the chain
+ */
+static void
+CompleteRequests (quadratic_async_pool*    pool,
+                  quadratic_async_request* chain,
+                  quadratic_batch_status   status);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Async solver interface implementation
+//------------------------------------------------------------------------------
+
+void
+AsyncOptionsInit (quadratic_async_options* options)
+{
+    if (options == NULL) return;
+
+    options->threads       = 0;
+    options->coalesce_rows = ASYNC_DEFAULT_COALESCE_ROWS;
+
+    BatchOptionsInit (&options->solve);
+}
+
+
+quadratic_async_pool*
+AsyncPoolConstructor (const quadratic_async_options* options)
+{
+    quadratic_async_pool* pool = calloc (1, sizeof (quadratic_async_pool));
+    if (pool == NULL) return NULL;
+
+    if (options != NULL) pool->options = *options;
+    else AsyncOptionsInit (&pool->options);
+
+    size_t threads = pool->options.threads;
+    if (threads == 0)
+    {
+        long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (size_t) cpus : 1;
+    }
+
+    pthread_mutex_init (&pool->lock,     NULL);
+    pthread_cond_init  (&pool->has_work, NULL);
+    pthread_cond_init  (&pool->has_done, NULL);
+
+    pool->thread_ids = calloc (threads, sizeof (pthread_t));
+    if (pool->thread_ids == NULL) return AsyncPoolDestructor (pool);
+
+    for (size_t i = 0; i < threads; i++)
+    {
+        if (pthread_create (&pool->thread_ids[i], NULL, RunWorker, pool) != 0)
+            return AsyncPoolDestructor (pool);
+
+        pool->threads++;
+    }
+
+    return pool;
+}
+
+
+quadratic_async_pool*
+AsyncPoolDestructor (quadratic_async_pool* pool)
+{
+    if (pool == NULL) return NULL;
+
+    pthread_mutex_lock (&pool->lock);
+    pool->is_stopping = true;
+    pthread_cond_broadcast (&pool->has_work);
+    pthread_mutex_unlock (&pool->lock);
+
+    for (size_t i = 0; i < pool->threads; i++)
+        pthread_join (pool->thread_ids[i], NULL);
+
+    pthread_mutex_destroy (&pool->lock);
+    pthread_cond_destroy  (&pool->has_work);
+    pthread_cond_destroy  (&pool->has_done);
+
+    free (pool->thread_ids);
+
+    free (pool);
+    return NULL;
+}
+
+
+quadratic_batch_status
+AsyncSubmit (quadratic_async_pool*     pool,
+             quadratic_async_request*  request,
+             quadratic_equation_batch* batch,
+             quadratic_async_callback  callback,
+             void*                     user_data)
+{
+    if (pool == NULL || request == NULL || batch == NULL)
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    request->batch     = batch;
+    request->callback  = callback;
+    request->user_data = user_data;
+    request->status    = QUADRATIC_BATCH_SUCCESS;
+    request->done      = false;
+    request->next      = NULL;
+
+    pthread_mutex_lock (&pool->lock);
+
+    if (pool->tail == NULL) pool->head       = request;
+    else                    pool->tail->next = request;
+    pool->tail = request;
+
+    pthread_cond_signal (&pool->has_work);
+    pthread_mutex_unlock (&pool->lock);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+bool
+AsyncPoll (quadratic_async_pool*    pool,
+           quadratic_async_request* request)
+{
+    if (pool == NULL || request == NULL) return false;
+
+    pthread_mutex_lock (&pool->lock);
+    const bool is_done = request->done;
+    pthread_mutex_unlock (&pool->lock);
+
+    return is_done;
+}
+
+
+quadratic_batch_status
+AsyncWait (quadratic_async_pool*    pool,
+           quadratic_async_request* request)
+{
+    if (pool == NULL || request == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    pthread_mutex_lock (&pool->lock);
+
+    while (!request->done)
+        pthread_cond_wait (&pool->has_done, &pool->lock);
+
+    const quadratic_batch_status status = request->status;
+    pthread_mutex_unlock (&pool->lock);
+
+    return status;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static void*
+RunWorker (void* pool_ptr)
+{
+    quadratic_async_pool* pool = pool_ptr;
+
+    quadratic_equation_batch* buffer =
+        BatchConstructor (pool->options.coalesce_rows);
+
+    pthread_mutex_lock (&pool->lock);
+
+    while (true)
+    {
+        while (pool->head == NULL && !pool->is_stopping)
+            pthread_cond_wait (&pool->has_work, &pool->lock);
+
+        if (pool->head == NULL) break;
+
+        size_t rows = 0;
+        quadratic_async_request* chain = PopRequests (pool, &rows);
+
+        pthread_mutex_unlock (&pool->lock);
+
+        quadratic_batch_status status = QUADRATIC_BATCH_SUCCESS;
+
+        if (chain->next == NULL)
+            status = SolveQuadraticBatch (chain->batch, &pool->options.solve);
+
+        else if (buffer == NULL)
+            status = QUADRATIC_BATCH_ALLOC_ERROR;
+
+        else
+            status = SolveCoalesced (pool, buffer, chain, rows);
+
+        CompleteRequests (pool, chain, status);
+
+        pthread_mutex_lock (&pool->lock);
+    }
+
+    pthread_mutex_unlock (&pool->lock);
+
+    buffer = BatchDestructor (buffer);
+
+    return NULL;
+}
+
+
+static quadratic_async_request*
+PopRequests (quadratic_async_pool* pool,
+             size_t*               rows)
+{
+    const size_t coalesce_rows = pool->options.coalesce_rows;
+
+    quadratic_async_request* chain = pool->head;
+    quadratic_async_request* last  = chain;
+    *rows = chain->batch->size;
+
+    if (*rows < coalesce_rows)
+    {
+        while (last->next != NULL &&
+               *rows + last->next->batch->size <= coalesce_rows)
+        {
+            last   = last->next;
+            *rows += last->batch->size;
+        }
+    }
+
+    pool->head = last->next;
+    if (pool->head == NULL) pool->tail = NULL;
+
+    last->next = NULL;
+
+    return chain;
+}
+
+
+static quadratic_batch_status
+SolveCoalesced (const quadratic_async_pool* pool,
+                quadratic_equation_batch*   buffer,
+                quadratic_async_request*    chain,
+                size_t                      rows)
+{
+    const size_t capacity = buffer->size;
+    size_t offset = 0;
+
+    for (quadratic_async_request* request = chain; request != NULL;
+         request = request->next)
+    {
+        const quadratic_equation_batch* batch = request->batch;
+        const size_t size = batch->size * sizeof (double);
+
+        if (batch->size == 0) continue;
+
+        memcpy (buffer->a + offset, batch->a, size);
+        memcpy (buffer->b + offset, batch->b, size);
+        memcpy (buffer->c + offset, batch->c, size);
+        offset += batch->size;
+    }
+
+    buffer->size = rows;
+    quadratic_batch_status status =
+        SolveQuadraticBatch (buffer, &pool->options.solve);
+    buffer->size = capacity;
+
+    offset = 0;
+
+    for (quadratic_async_request* request = chain; request != NULL;
+         request = request->next)
+    {
+        quadratic_equation_batch* batch = request->batch;
+        const size_t size = batch->size * sizeof (double);
+
+        if (batch->size == 0) continue;
+
+        memcpy (batch->x1, buffer->x1 + offset, size);
+        memcpy (batch->x2, buffer->x2 + offset, size);
+        memcpy (batch->roots_number, buffer->roots_number + offset,
+                batch->size * sizeof (quadratic_equation_roots_number));
+        offset += batch->size;
+    }
+
+    return status;
+}
+
+
+static void
+CompleteRequests (quadratic_async_pool*    pool,
+                  quadratic_async_request* chain,
+                  quadratic_batch_status   status)
+{
+    quadratic_async_request* request = chain;
+
+    while (request != NULL)
+    {
+        quadratic_async_request* next      = request->next;
+        quadratic_async_callback callback  = request->callback;
+        void*                    user_data = request->user_data;
+
+        pthread_mutex_lock (&pool->lock);
+        request->status = status;
+        request->done   = true;
+        pthread_cond_broadcast (&pool->has_done);
+        pthread_mutex_unlock (&pool->lock);
+
+        // A waiter may free the request now, so the callback is the last access
+        if (callback != NULL) callback (request, user_data);
+
+        request = next;
+    }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
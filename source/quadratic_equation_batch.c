@@ -0,0 +1,1456 @@
+/**
+ * @file quadratic_equation_batch.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Batch quadratic equation solver implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "quadratic_equation_batch.h"
+#include "quadratic_equation_special.h"
+#include "quadratic_equation_row.h"
+#include "doubles_compare.h"
+#include "monotonic_clock.h"
+
+
+
+#include <string.h>
+#include <sys/mman.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Default condition threshold for the polishing stage
+static const double BATCH_DEFAULT_POLISH_THRESHOLD  = 1e-6;
+
+/// @brief Default number of Halley iterations for the polishing stage
+static const size_t BATCH_DEFAULT_POLISH_ITERATIONS = 2;
+
+/// @brief Number of rows classified at once by the classified solver
+static const size_t BATCH_BLOCK_SIZE = 1024;
+
+/// @brief Bits of the reciprocal estimate: \f$ 1 / x \approx bits^{-1}(M - bits(x)) \f$
+static const uint64_t BATCH_RECIPROCAL_MAGIC = 0x7FDE623822FC16E6ULL;
+
+/// @brief Newton iterations refining the reciprocal estimate to full precision
+static const size_t BATCH_RECIPROCAL_ITERATIONS = 4;
+
+/// @brief Bounds of the values whose reciprocal estimate is normal
+static const double BATCH_RECIPROCAL_MIN = 0x1p-1000;
+static const double BATCH_RECIPROCAL_MAX = 0x1p+1000;
+
+/// @brief Maximum number of row groups, classes or patterns
+#define BATCH_MAX_GROUPS QUADRATIC_CLASS_COUNT
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Classifies one row of the batch without branches
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ *
+ * @retval Class of the row, the same decision as SolveQuadraticRow() makes
+ */
+static inline quadratic_batch_class
+ClassifyRow (double a_coef,
+             double b_coef,
+             double c_coef);
+
+
+/**
+ * @brief Stream compacts rows into per-class lists
+ *
+ * @param row_classes    Classes of the rows
+ * @param count          Number of rows
+ * @param first_row      Index of the first row in the batch
+ * @param classes_number Number of classes, at most BATCH_MAX_GROUPS
+ * @param indices        Output row indices grouped by class
+ * @param offsets        Output class bounds, classes_number + 1 elements
+ */
+static void
+PartitionRows (const unsigned char* row_classes,
+               size_t               count,
+               size_t               first_row,
+               size_t               classes_number,
+               size_t*              indices,
+               size_t*              offsets);
+
+
+/**
+ * @brief Solves the rows of one class by its straight-line kernel
+ *
+ * @param batch      Pointer to the batch
+ * @param row_class  Class of the rows
+ * @param indices    Row indices
+ * @param count      Number of rows
+ */
+static void
+SolveClassRows (quadratic_equation_batch* batch,
+                quadratic_batch_class     row_class,
+                const size_t*             indices,
+                size_t                    count);
+
+
+/**
+ * @brief Classified solver, @see SolveQuadraticBatch()
+ */
+static quadratic_batch_status
+SolveBatchClassified (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Solves the rows of one pattern by its specialized kernel
+ *
+ * @param batch   Pointer to the batch
+ * @param pattern Pattern of the rows
+ * @param indices Row indices
+ * @param count   Number of rows
+ */
+static void
+SolvePatternRows (quadratic_equation_batch* batch,
+                  quadratic_batch_pattern   pattern,
+                  const size_t*             indices,
+                  size_t                    count);
+
+
+/**
+ * @brief Pattern routing solver, @see SolveQuadraticBatch()
+ */
+static quadratic_batch_status
+SolveBatchRouted (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Solves one row of the batch without divisions
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ * @param x1     Pointer to the first  root
+ * @param x2     Pointer to the second root
+ *
+ * @retval Number of roots, the same as SolveQuadraticRow() returns
+ */
+static inline quadratic_equation_roots_number
+SolveBatchRowFast (double  a_coef,
+                   double  b_coef,
+                   double  c_coef,
+                   double* x1,
+                   double* x2);
+
+
+/**
+ * @brief Finds the reciprocal from a bit level estimate refined by Newton
+ *
+ * @param divisor Value to invert
+ *
+ * @retval \f$ 1 / divisor \f$ within 1 ULP
+ * @retval NAN if the divisor is out of [BATCH_RECIPROCAL_MIN,
+ * BATCH_RECIPROCAL_MAX] by absolute value (zero, subnormal, huge,
+ * infinite or NaN), where the estimate fails
+ *
+ * @details Every iteration \f$ y = y + y(1 - xy) \f$ doubles
+ * the correct bits of the estimate, FMA keeps \f$ 1 - xy \f$ exact
+ */
+static inline double
+ReciprocalFast (double divisor);
+
+
+/**
+ * @brief Divides the value by multiplying by the reciprocal
+ *
+ * @param value      Value to divide
+ * @param divisor    Divisor
+ * @param reciprocal ReciprocalFast() of the divisor
+ *
+ * @retval \f$ value / divisor \f$ within 2 ULP,
+ * exact division if the reciprocal is NaN
+ */
+static inline double
+DivideFast (double value,
+            double divisor,
+            double reciprocal);
+
+
+/**
+ * @brief Orders two roots of every row ascending by selects
+ *
+ * @param batch Pointer to the solved batch
+ */
+static void
+SortBatchRoots (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Orders two roots ascending by selects
+ *
+ * @param x1 Pointer to the first  root
+ * @param x2 Pointer to the second root
+ *
+ * @details NaN roots are never moved
+ */
+static inline void
+SortRootsPair (double* x1,
+               double* x2);
+
+
+/**
+ * @brief Checks whether the row needs polishing
+ *
+ * @param a_coef    Coefficient before \f$ x^2 \f$
+ * @param b_coef    Coefficient before \f$ x \f$
+ * @param c_coef    Free coefficient
+ * @param threshold Condition threshold
+ *
+ * @retval true if the roots may have lost precision
+ */
+static inline bool
+IsIllConditioned (double a_coef,
+                  double b_coef,
+                  double c_coef,
+                  double threshold);
+
+
+/**
+ * @brief Checks if the solved row is refined by the polishing stage
+ *
+ * @retval true for a quadratic row with roots that is ill-conditioned,
+ * @see IsIllConditioned()
+ */
+static inline bool
+IsPolishedRow (double                          a_coef,
+               double                          b_coef,
+               double                          c_coef,
+               quadratic_equation_roots_number roots_number,
+               double                          threshold);
+
+
+/**
+ * @brief Polishing stage of the batch solver
+ *
+ * @param batch   Pointer to the solved batch
+ * @param options Pointer to the options
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Compacts ill-conditioned rows into a dense subbatch,
+ * refines their roots and scatters the roots back
+ */
+static quadratic_batch_status
+PolishBatchRoots (quadratic_equation_batch*      batch,
+                  const quadratic_batch_options* options);
+
+
+/**
+ * @brief Evaluates \f$ ax^2 + bx + c \f$ by Horner scheme with FMA
+ */
+static inline double
+EvaluateResidual (double a_coef,
+                  double b_coef,
+                  double c_coef,
+                  double x);
+
+
+/**
+ * @brief Makes one Halley step for the root
+ *
+ * @retval Refined root if it decreases the residual, old root otherwise
+ */
+static inline double
+HalleyStep (double a_coef,
+            double b_coef,
+            double c_coef,
+            double x);
+
+
+/**
+ * @brief Finds the residual of the row, @see VerifyQuadraticBatch()
+ *
+ * @retval Largest residual of the valid roots, 0 if there are none
+ */
+static inline double
+RowResidual (double                          a_coef,
+             double                          b_coef,
+             double                          c_coef,
+             double                          x1,
+             double                          x2,
+             quadratic_equation_roots_number roots_number);
+
+
+/**
+ * @brief Finds the residual of the root relative to the coefficients magnitudes
+ *
+ * @retval \f$ |ax^2 + bx + c| / (|a|x^2 + |b||x| + |c|) \f$,
+ * 0 for zero root of the equation with zero free coefficient
+ */
+static inline double
+RootResidual (double a_coef,
+              double b_coef,
+              double c_coef,
+              double x);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Batch solver interface implementation
+//------------------------------------------------------------------------------
+
+quadratic_equation_batch*
+BatchConstructor (size_t size)
+{
+    quadratic_equation_batch* batch =
+        calloc (1, sizeof (quadratic_equation_batch));
+    if (batch == NULL) return NULL;
+
+    batch->size = size;
+
+    batch->a  = calloc (size, sizeof (double));
+    batch->b  = calloc (size, sizeof (double));
+    batch->c  = calloc (size, sizeof (double));
+    batch->x1 = calloc (size, sizeof (double));
+    batch->x2 = calloc (size, sizeof (double));
+    batch->roots_number =
+        calloc (size, sizeof (quadratic_equation_roots_number));
+
+    if (batch->a  == NULL || batch->b  == NULL || batch->c == NULL ||
+        batch->x1 == NULL || batch->x2 == NULL ||
+        batch->roots_number == NULL)
+        return BatchDestructor (batch);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        batch->x1[i] = NAN;
+        batch->x2[i] = NAN;
+        batch->roots_number[i] = QUADRATIC_EQUATION_NOT_SOLVED;
+    }
+
+    return batch;
+}
+
+
+quadratic_equation_batch*
+BatchDestructor (quadratic_equation_batch* batch)
+{
+    if (batch == NULL) return NULL;
+
+    if (batch->mapping != NULL)
+        munmap (batch->mapping, batch->mapping_size);
+
+    else
+    {
+        free (batch->a);
+        free (batch->b);
+        free (batch->c);
+        free (batch->x1);
+        free (batch->x2);
+        free (batch->roots_number);
+    }
+
+    free (batch);
+    return NULL;
+}
+
+
+void
+BatchOptionsInit (quadratic_batch_options* options)
+{
+    if (options == NULL) return;
+
+    options->polish_roots      = false;
+    options->polish_threshold  = BATCH_DEFAULT_POLISH_THRESHOLD;
+    options->polish_iterations = BATCH_DEFAULT_POLISH_ITERATIONS;
+    options->classify_first    = false;
+    options->route_patterns    = false;
+    options->sort_roots        = false;
+    options->fast_division     = false;
+}
+
+
+bool
+BatchOptionsAreValid (const quadratic_batch_options* options)
+{
+    if (options == NULL) return false;
+
+    return (int) options->classify_first + (int) options->route_patterns +
+           (int) options->fast_division <= 1;
+}
+
+
+quadratic_batch_status
+SolveQuadraticBatch (quadratic_equation_batch*      batch,
+                     const quadratic_batch_options* options)
+{
+    if (batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+    if (batch->size == 0) return QUADRATIC_BATCH_SUCCESS;
+
+    if (batch->a  == NULL || batch->b  == NULL || batch->c == NULL ||
+        batch->x1 == NULL || batch->x2 == NULL ||
+        batch->roots_number == NULL)
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    quadratic_batch_options default_options = {0};
+    if (options == NULL)
+    {
+        BatchOptionsInit (&default_options);
+        options = &default_options;
+    }
+
+    if (!BatchOptionsAreValid (options)) return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (options->classify_first)
+    {
+        quadratic_batch_status status = SolveBatchClassified (batch);
+        if (status != QUADRATIC_BATCH_SUCCESS) return status;
+    }
+
+    else if (options->route_patterns)
+    {
+        quadratic_batch_status status = SolveBatchRouted (batch);
+        if (status != QUADRATIC_BATCH_SUCCESS) return status;
+    }
+
+    else if (options->fast_division)
+    {
+        for (size_t i = 0; i < batch->size; i++)
+            batch->roots_number[i] =
+                SolveBatchRowFast (batch->a[i], batch->b[i], batch->c[i],
+                                   &batch->x1[i], &batch->x2[i]);
+    }
+
+    else
+    {
+        for (size_t i = 0; i < batch->size; i++)
+            batch->roots_number[i] =
+                SolveQuadraticRow (batch->a[i], batch->b[i], batch->c[i],
+                                   &batch->x1[i], &batch->x2[i]);
+    }
+
+    if (options->polish_roots)
+    {
+        quadratic_batch_status status = PolishBatchRoots (batch, options);
+        if (status != QUADRATIC_BATCH_SUCCESS) return status;
+    }
+
+    if (options->sort_roots)
+        SortBatchRoots (batch);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_root_list*
+RootListConstructor (size_t capacity)
+{
+    quadratic_root_list* list = calloc (1, sizeof (quadratic_root_list));
+    if (list == NULL) return NULL;
+
+    list->rows  = calloc (capacity, sizeof (size_t));
+    list->roots = calloc (capacity, sizeof (double));
+
+    if ((list->rows == NULL || list->roots == NULL) && capacity != 0)
+        return RootListDestructor (list);
+
+    list->capacity = capacity;
+
+    return list;
+}
+
+
+quadratic_root_list*
+RootListDestructor (quadratic_root_list* list)
+{
+    if (list == NULL) return NULL;
+
+    free (list->rows);
+    free (list->roots);
+
+    free (list);
+    return NULL;
+}
+
+
+quadratic_batch_status
+SolveQuadraticBatchInRange (const quadratic_equation_batch* batch,
+                            double                          low,
+                            double                          high,
+                            quadratic_root_list*            list,
+                            size_t*                         roots_count)
+{
+    if (batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (batch->size != 0 &&
+        (batch->a == NULL || batch->b == NULL || batch->c == NULL))
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (list != NULL && list->capacity < 2 * batch->size)
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        double x1 = NAN;
+        double x2 = NAN;
+
+        SolveQuadraticRow (batch->a[i], batch->b[i], batch->c[i], &x1, &x2);
+        SortRootsPair (&x1, &x2);
+
+        const size_t x1_in_range = (x1 >= low) & (x1 <= high);
+        const size_t x2_in_range = (x2 >= low) & (x2 <= high);
+
+        if (list != NULL)
+        {
+            list->rows [count] = i;
+            list->roots[count] = x1;
+            count += x1_in_range;
+
+            list->rows [count] = i;
+            list->roots[count] = x2;
+            count += x2_in_range;
+        }
+
+        else
+            count += x1_in_range + x2_in_range;
+    }
+
+    if (list != NULL) list->size = count;
+    if (roots_count != NULL) *roots_count = count;
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_batch_status
+SolveQuadraticBatchDirty (quadratic_equation_batch*      batch,
+                          const quadratic_batch_options* options,
+                          uint64_t*                      dirty)
+{
+    if (batch == NULL || dirty == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+    if (batch->size == 0) return QUADRATIC_BATCH_SUCCESS;
+
+    if (batch->a  == NULL || batch->b  == NULL || batch->c == NULL ||
+        batch->x1 == NULL || batch->x2 == NULL ||
+        batch->roots_number == NULL)
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    quadratic_batch_options default_options = {0};
+    if (options == NULL)
+    {
+        BatchOptionsInit (&default_options);
+        options = &default_options;
+    }
+
+    if (!BatchOptionsAreValid (options)) return QUADRATIC_BATCH_BAD_ARGS;
+
+    const size_t words = QUADRATIC_BATCH_DIRTY_WORDS (batch->size);
+
+    for (size_t word = 0; word < words; word++)
+    {
+        uint64_t bits = dirty[word];
+        dirty[word] = 0;
+
+        while (bits != 0)
+        {
+            const size_t i = word * QUADRATIC_BATCH_DIRTY_WORD_ROWS +
+                             (size_t) __builtin_ctzll (bits);
+            bits &= bits - 1;
+
+            if (i >= batch->size) break;
+
+            batch->roots_number[i] = options->fast_division ?
+                SolveBatchRowFast (batch->a[i], batch->b[i], batch->c[i],
+                                   &batch->x1[i], &batch->x2[i]) :
+                SolveQuadraticRow (batch->a[i], batch->b[i], batch->c[i],
+                                   &batch->x1[i], &batch->x2[i]);
+
+            if (options->polish_roots &&
+                IsPolishedRow (batch->a[i], batch->b[i], batch->c[i],
+                               batch->roots_number[i],
+                               options->polish_threshold))
+            {
+                for (size_t iteration = 0;
+                     iteration < options->polish_iterations; iteration++)
+                {
+                    batch->x1[i] = HalleyStep (batch->a[i], batch->b[i],
+                                               batch->c[i], batch->x1[i]);
+                    batch->x2[i] = HalleyStep (batch->a[i], batch->b[i],
+                                               batch->c[i], batch->x2[i]);
+                }
+            }
+
+            if (options->sort_roots)
+                SortRootsPair (&batch->x1[i], &batch->x2[i]);
+        }
+    }
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+void
+BatchMarkDirty (uint64_t* dirty,
+                size_t    row)
+{
+    if (dirty == NULL) return;
+
+    dirty[row / QUADRATIC_BATCH_DIRTY_WORD_ROWS] |=
+        1ULL << (row % QUADRATIC_BATCH_DIRTY_WORD_ROWS);
+}
+
+
+quadratic_batch_status
+VerifyQuadraticBatch (const quadratic_equation_batch* batch,
+                      double                          threshold,
+                      double*                         residuals,
+                      uint64_t*                       flagged,
+                      size_t*                         flagged_count)
+{
+    if (batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (batch->size != 0 &&
+        (batch->a  == NULL || batch->b  == NULL || batch->c == NULL ||
+         batch->x1 == NULL || batch->x2 == NULL ||
+         batch->roots_number == NULL))
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    const double* a_column  = batch->a;
+    const double* b_column  = batch->b;
+    const double* c_column  = batch->c;
+    const double* x1_column = batch->x1;
+    const double* x2_column = batch->x2;
+    const quadratic_equation_roots_number* roots_number = batch->roots_number;
+
+    const size_t words = QUADRATIC_BATCH_DIRTY_WORDS (batch->size);
+    size_t count = 0;
+
+    for (size_t word = 0; word < words; word++)
+    {
+        const size_t begin = word * QUADRATIC_BATCH_DIRTY_WORD_ROWS;
+
+        size_t rows = batch->size - begin;
+        if (rows > QUADRATIC_BATCH_DIRTY_WORD_ROWS)
+            rows = QUADRATIC_BATCH_DIRTY_WORD_ROWS;
+
+        double word_residuals[QUADRATIC_BATCH_DIRTY_WORD_ROWS];
+
+        for (size_t i = 0; i < rows; i++)
+            word_residuals[i] =
+                RowResidual (a_column[begin + i],  b_column[begin + i],
+                             c_column[begin + i],  x1_column[begin + i],
+                             x2_column[begin + i], roots_number[begin + i]);
+
+        uint64_t bits = 0;
+        for (size_t i = 0; i < rows; i++)
+            bits |= (uint64_t) !(word_residuals[i] <= threshold) << i;
+
+        if (residuals != NULL)
+            memcpy (residuals + begin, word_residuals, rows * sizeof (double));
+
+        if (flagged != NULL) flagged[word] = bits;
+
+        count += (size_t) __builtin_popcountll (bits);
+    }
+
+    if (flagged_count != NULL) *flagged_count = count;
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_batch_status
+SolveQuadraticBatchVerified (quadratic_equation_batch*      batch,
+                             const quadratic_batch_options* options,
+                             double                         threshold,
+                             double*                        residuals,
+                             uint64_t*                      flagged,
+                             size_t*                        flagged_count)
+{
+    if (batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    size_t count = 0;
+
+    for (size_t first_row = 0; first_row < batch->size;
+                               first_row += BATCH_BLOCK_SIZE)
+    {
+        const size_t rows = (batch->size - first_row < BATCH_BLOCK_SIZE) ?
+                             batch->size - first_row : BATCH_BLOCK_SIZE;
+
+        quadratic_equation_batch block = {0};
+        BatchSlice (batch, first_row, rows, &block);
+
+        quadratic_batch_status status = SolveQuadraticBatch (&block, options);
+        if (status != QUADRATIC_BATCH_SUCCESS) return status;
+
+        double*   block_residuals = (residuals == NULL) ? NULL :
+                                    residuals + first_row;
+        uint64_t* block_flagged   = (flagged == NULL) ? NULL :
+            flagged + first_row / QUADRATIC_BATCH_DIRTY_WORD_ROWS;
+
+        size_t block_count = 0;
+        status = VerifyQuadraticBatch (&block, threshold, block_residuals,
+                                       block_flagged, &block_count);
+        if (status != QUADRATIC_BATCH_SUCCESS) return status;
+
+        count += block_count;
+    }
+
+    if (flagged_count != NULL) *flagged_count = count;
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+void
+CancelTokenInit (quadratic_cancel_token* token,
+                 double                  timeout)
+{
+    if (token == NULL) return;
+
+    atomic_init (&token->is_cancelled, false);
+    token->deadline = (timeout > 0) ? MonotonicSeconds () + timeout : 0;
+}
+
+
+void
+CancelTokenCancel (quadratic_cancel_token* token)
+{
+    if (token == NULL) return;
+
+    atomic_store_explicit (&token->is_cancelled, true, memory_order_release);
+}
+
+
+bool
+CancelTokenIsCancelled (quadratic_cancel_token* token)
+{
+    if (token == NULL) return false;
+
+    if (atomic_load_explicit (&token->is_cancelled, memory_order_acquire))
+        return true;
+
+    return token->deadline > 0 && MonotonicSeconds () >= token->deadline;
+}
+
+
+quadratic_batch_status
+SolveQuadraticBatchCancellable (quadratic_equation_batch*      batch,
+                                const quadratic_batch_options* options,
+                                quadratic_cancel_token*        token,
+                                size_t*                        solved_rows)
+{
+    if (solved_rows != NULL) *solved_rows = 0;
+    if (batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    quadratic_batch_status status = QUADRATIC_BATCH_SUCCESS;
+    size_t first_row = 0;
+
+    while (first_row < batch->size && status == QUADRATIC_BATCH_SUCCESS)
+    {
+        if (CancelTokenIsCancelled (token))
+        {
+            status = QUADRATIC_BATCH_CANCELLED;
+            break;
+        }
+
+        size_t rows = batch->size - first_row;
+        if (rows > QUADRATIC_BATCH_CANCEL_CHUNK_ROWS)
+            rows = QUADRATIC_BATCH_CANCEL_CHUNK_ROWS;
+
+        quadratic_equation_batch chunk = {0};
+        BatchSlice (batch, first_row, rows, &chunk);
+
+        status = SolveQuadraticBatch (&chunk, options);
+        if (status == QUADRATIC_BATCH_SUCCESS) first_row += rows;
+    }
+
+    if (solved_rows != NULL) *solved_rows = first_row;
+
+    return status;
+}
+
+
+void
+BatchSlice (const quadratic_equation_batch* batch,
+            size_t                          first_row,
+            size_t                          rows,
+            quadratic_equation_batch*       slice)
+{
+    if (batch == NULL || slice == NULL) return;
+
+    slice->size         = rows;
+    slice->a            = (batch->a  != NULL) ? batch->a  + first_row : NULL;
+    slice->b            = (batch->b  != NULL) ? batch->b  + first_row : NULL;
+    slice->c            = (batch->c  != NULL) ? batch->c  + first_row : NULL;
+    slice->x1           = (batch->x1 != NULL) ? batch->x1 + first_row : NULL;
+    slice->x2           = (batch->x2 != NULL) ? batch->x2 + first_row : NULL;
+    slice->roots_number = (batch->roots_number != NULL) ?
+                          batch->roots_number + first_row : NULL;
+    slice->mapping      = NULL;
+    slice->mapping_size = 0;
+}
+
+
+quadratic_batch_classes*
+BatchClassesConstructor (size_t size)
+{
+    quadratic_batch_classes* classes =
+        calloc (1, sizeof (quadratic_batch_classes));
+    if (classes == NULL) return NULL;
+
+    classes->indices = calloc (size, sizeof (size_t));
+    if (classes->indices == NULL && size != 0)
+        return BatchClassesDestructor (classes);
+
+    classes->capacity = size;
+
+    return classes;
+}
+
+
+quadratic_batch_classes*
+BatchClassesDestructor (quadratic_batch_classes* classes)
+{
+    if (classes == NULL) return NULL;
+
+    free (classes->indices);
+
+    free (classes);
+    return NULL;
+}
+
+
+quadratic_batch_status
+BatchClassify (const quadratic_equation_batch* batch,
+               quadratic_batch_classes*        classes)
+{
+    if (batch == NULL || classes == NULL ||
+        classes->capacity < batch->size)
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (batch->size != 0 &&
+        (batch->a == NULL || batch->b == NULL || batch->c == NULL))
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    unsigned char* row_classes = malloc (batch->size + 1);
+    if (row_classes == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    for (size_t i = 0; i < batch->size; i++)
+        row_classes[i] =
+            (unsigned char) ClassifyRow (batch->a[i], batch->b[i], batch->c[i]);
+
+    PartitionRows (row_classes, batch->size, 0, QUADRATIC_CLASS_COUNT,
+                   classes->indices, classes->offsets);
+    classes->size = batch->size;
+
+    free (row_classes);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_batch_class
+BatchClassifyRow (double a_coef,
+                  double b_coef,
+                  double c_coef)
+{
+    return ClassifyRow (a_coef, b_coef, c_coef);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static inline quadratic_equation_roots_number
+SolveBatchRowFast (double  a_coef,
+                   double  b_coef,
+                   double  c_coef,
+                   double* x1,
+                   double* x2)
+{
+    *x1 = NAN;
+    *x2 = NAN;
+
+    if (CompareDoubles (a_coef, 0) == DOUBLES_CMP_EQUAL)
+    {
+        doubles_cmp_status b_cmp_status = CompareDoubles (b_coef, 0);
+        doubles_cmp_status c_cmp_status = CompareDoubles (c_coef, 0);
+
+        if (b_cmp_status == DOUBLES_CMP_EQUAL)
+            return (c_cmp_status == DOUBLES_CMP_EQUAL) ?
+                   QUADRATIC_EQUATION_INF_ROOTS :
+                   QUADRATIC_EQUATION_NO_ROOTS;
+
+        *x1 = DivideFast (-c_coef, b_coef, ReciprocalFast (b_coef));
+        return QUADRATIC_EQUATION_ONE_ROOT;
+    }
+
+    const double discriminant = b_coef * b_coef - 4 * a_coef * c_coef;
+    const double a_reciprocal = ReciprocalFast (a_coef);
+
+    switch (CompareDoubles (discriminant, 0))
+    {
+        case DOUBLES_CMP_LESS:
+            return QUADRATIC_EQUATION_NO_ROOTS;
+
+        case DOUBLES_CMP_EQUAL:
+            *x1 = DivideFast (-b_coef * 0.5, a_coef, a_reciprocal);
+            return QUADRATIC_EQUATION_ONE_ROOT;
+
+        case DOUBLES_CMP_GREATER:
+        {
+            const double discriminant_sqrt = sqrt (discriminant);
+            *x1 = DivideFast ((-b_coef - discriminant_sqrt) * 0.5,
+                              a_coef, a_reciprocal);
+            *x2 = DivideFast ((-b_coef + discriminant_sqrt) * 0.5,
+                              a_coef, a_reciprocal);
+            return QUADRATIC_EQUATION_TWO_ROOTS;
+        }
+
+        case DOUBLES_CMP_UNDEFINED:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        default:
+            return QUADRATIC_EQUATION_NOT_SOLVED;
+    }
+}
+
+
+static inline double
+ReciprocalFast (double divisor)
+{
+    const double divisor_abs = fabs (divisor);
+    if (!(divisor_abs >= BATCH_RECIPROCAL_MIN &&
+          divisor_abs <= BATCH_RECIPROCAL_MAX))
+        return NAN;
+
+    uint64_t bits = 0;
+    memcpy (&bits, &divisor, sizeof (double));
+    bits = BATCH_RECIPROCAL_MAGIC - bits;
+
+    double reciprocal = 0;
+    memcpy (&reciprocal, &bits, sizeof (double));
+
+    for (size_t i = 0; i < BATCH_RECIPROCAL_ITERATIONS; i++)
+        reciprocal = fma (reciprocal, fma (-divisor, reciprocal, 1), reciprocal);
+
+    return reciprocal;
+}
+
+
+static inline double
+DivideFast (double value,
+            double divisor,
+            double reciprocal)
+{
+    return isnan (reciprocal) ? value / divisor : value * reciprocal;
+}
+
+
+static inline quadratic_batch_class
+ClassifyRow (double a_coef,
+             double b_coef,
+             double c_coef)
+{
+    const double discriminant = b_coef * b_coef - 4 * a_coef * c_coef;
+
+    const int a_is_zero = fabs (a_coef) <= DOUBLES_CMP_TOLERANCE;
+    const int b_is_zero = fabs (b_coef) <= DOUBLES_CMP_TOLERANCE;
+    const int c_is_zero = fabs (c_coef) <= DOUBLES_CMP_TOLERANCE;
+
+    const int d_is_nan     = isnan (discriminant) != 0;
+    const int d_is_less    = discriminant < -DOUBLES_CMP_TOLERANCE;
+    const int d_is_greater = discriminant >  DOUBLES_CMP_TOLERANCE;
+    const int d_is_equal   = !d_is_nan & !d_is_less & !d_is_greater;
+
+    const int quadratic_class = d_is_nan     * QUADRATIC_CLASS_INVALID   +
+                                d_is_less    * QUADRATIC_CLASS_NO_ROOTS  +
+                                d_is_greater * QUADRATIC_CLASS_TWO_ROOTS +
+                                d_is_equal   * QUADRATIC_CLASS_ONE_ROOT;
+
+    const int linear_class = (1 - b_is_zero) * QUADRATIC_CLASS_LINEAR +
+                             b_is_zero * (c_is_zero * QUADRATIC_CLASS_INF_ROOTS +
+                                    (1 - c_is_zero) * QUADRATIC_CLASS_NO_ROOTS);
+
+    return (quadratic_batch_class) (a_is_zero       * linear_class +
+                                    (1 - a_is_zero) * quadratic_class);
+}
+
+
+static void
+PartitionRows (const unsigned char* row_classes,
+               size_t               count,
+               size_t               first_row,
+               size_t               classes_number,
+               size_t*              indices,
+               size_t*              offsets)
+{
+    size_t positions[BATCH_MAX_GROUPS] = {0};
+
+    for (size_t i = 0; i < count; i++)
+        positions[row_classes[i]]++;
+
+    offsets[0] = 0;
+    for (size_t k = 0; k < classes_number; k++)
+    {
+        offsets[k + 1] = offsets[k] + positions[k];
+        positions[k]   = offsets[k];
+    }
+
+    for (size_t i = 0; i < count; i++)
+        indices[positions[row_classes[i]]++] = first_row + i;
+}
+
+
+static void
+SolveClassRows (quadratic_equation_batch* batch,
+                quadratic_batch_class     row_class,
+                const size_t*             indices,
+                size_t                    count)
+{
+    const double* a  = batch->a;
+    const double* b  = batch->b;
+    const double* c  = batch->c;
+    double*       x1 = batch->x1;
+    double*       x2 = batch->x2;
+    quadratic_equation_roots_number* roots_number = batch->roots_number;
+
+    switch (row_class)
+    {
+        case QUADRATIC_CLASS_NO_ROOTS:
+            for (size_t i = 0; i < count; i++)
+            {
+                x1[indices[i]] = NAN;
+                x2[indices[i]] = NAN;
+                roots_number[indices[i]] = QUADRATIC_EQUATION_NO_ROOTS;
+            }
+            break;
+
+        case QUADRATIC_CLASS_ONE_ROOT:
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t row = indices[i];
+                x1[row] = -b[row] / 2 / a[row];
+                x2[row] = NAN;
+                roots_number[row] = QUADRATIC_EQUATION_ONE_ROOT;
+            }
+            break;
+
+        case QUADRATIC_CLASS_TWO_ROOTS:
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t row = indices[i];
+                const double sqrt_d = sqrt (b[row] * b[row] -
+                                            4 * a[row] * c[row]);
+                x1[row] = (-b[row] - sqrt_d) / 2 / a[row];
+                x2[row] = (-b[row] + sqrt_d) / 2 / a[row];
+                roots_number[row] = QUADRATIC_EQUATION_TWO_ROOTS;
+            }
+            break;
+
+        case QUADRATIC_CLASS_LINEAR:
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t row = indices[i];
+                x1[row] = -c[row] / b[row];
+                x2[row] = NAN;
+                roots_number[row] = QUADRATIC_EQUATION_ONE_ROOT;
+            }
+            break;
+
+        case QUADRATIC_CLASS_INF_ROOTS:
+            for (size_t i = 0; i < count; i++)
+            {
+                x1[indices[i]] = NAN;
+                x2[indices[i]] = NAN;
+                roots_number[indices[i]] = QUADRATIC_EQUATION_INF_ROOTS;
+            }
+            break;
+
+        case QUADRATIC_CLASS_INVALID:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        case QUADRATIC_CLASS_COUNT:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        default:
+            for (size_t i = 0; i < count; i++)
+            {
+                x1[indices[i]] = NAN;
+                x2[indices[i]] = NAN;
+                roots_number[indices[i]] = QUADRATIC_EQUATION_NOT_SOLVED;
+            }
+            break;
+    }
+}
+
+
+static quadratic_batch_status
+SolveBatchClassified (quadratic_equation_batch* batch)
+{
+    unsigned char* row_classes = malloc (BATCH_BLOCK_SIZE);
+    size_t*        indices     = malloc (BATCH_BLOCK_SIZE * sizeof (size_t));
+
+    if (row_classes == NULL || indices == NULL)
+    {
+        free (row_classes);
+        free (indices);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    size_t offsets[QUADRATIC_CLASS_COUNT + 1] = {0};
+
+    for (size_t first_row = 0; first_row < batch->size;
+                               first_row += BATCH_BLOCK_SIZE)
+    {
+        const size_t count = (batch->size - first_row < BATCH_BLOCK_SIZE) ?
+                              batch->size - first_row : BATCH_BLOCK_SIZE;
+
+        for (size_t i = 0; i < count; i++)
+            row_classes[i] =
+                (unsigned char) ClassifyRow (batch->a[first_row + i],
+                                             batch->b[first_row + i],
+                                             batch->c[first_row + i]);
+
+        PartitionRows (row_classes, count, first_row, QUADRATIC_CLASS_COUNT,
+                       indices, offsets);
+
+        for (size_t k = 0; k < QUADRATIC_CLASS_COUNT; k++)
+            SolveClassRows (batch, (quadratic_batch_class) k,
+                            indices + offsets[k], offsets[k + 1] - offsets[k]);
+    }
+
+    free (row_classes);
+    free (indices);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+static void
+SolvePatternRows (quadratic_equation_batch* batch,
+                  quadratic_batch_pattern   pattern,
+                  const size_t*             indices,
+                  size_t                    count)
+{
+    const double* a  = batch->a;
+    const double* b  = batch->b;
+    const double* c  = batch->c;
+    double*       x1 = batch->x1;
+    double*       x2 = batch->x2;
+    quadratic_equation_roots_number* roots_number = batch->roots_number;
+
+    switch (pattern)
+    {
+        case QUADRATIC_PATTERN_MONIC:
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t row = indices[i];
+                roots_number[row] =
+                    SolveMonicEquation (b[row], c[row], &x1[row], &x2[row]);
+            }
+            break;
+
+        case QUADRATIC_PATTERN_PURE:
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t row = indices[i];
+                roots_number[row] =
+                    SolvePureQuadraticEquation (a[row], c[row],
+                                                &x1[row], &x2[row]);
+            }
+            break;
+
+        case QUADRATIC_PATTERN_NO_FREE_TERM:
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t row = indices[i];
+                roots_number[row] =
+                    SolveNoFreeTermEquation (a[row], b[row],
+                                             &x1[row], &x2[row]);
+            }
+            break;
+
+        case QUADRATIC_PATTERN_GENERAL:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        case QUADRATIC_PATTERN_COUNT:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        default:
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t row = indices[i];
+                roots_number[row] =
+                    SolveQuadraticRow (a[row], b[row], c[row],
+                                       &x1[row], &x2[row]);
+            }
+            break;
+    }
+}
+
+
+static quadratic_batch_status
+SolveBatchRouted (quadratic_equation_batch* batch)
+{
+    unsigned char* row_patterns = malloc (BATCH_BLOCK_SIZE);
+    size_t*        indices      = malloc (BATCH_BLOCK_SIZE * sizeof (size_t));
+
+    if (row_patterns == NULL || indices == NULL)
+    {
+        free (row_patterns);
+        free (indices);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    size_t offsets[QUADRATIC_PATTERN_COUNT + 1] = {0};
+
+    for (size_t first_row = 0; first_row < batch->size;
+                               first_row += BATCH_BLOCK_SIZE)
+    {
+        const size_t count = (batch->size - first_row < BATCH_BLOCK_SIZE) ?
+                              batch->size - first_row : BATCH_BLOCK_SIZE;
+
+        for (size_t i = 0; i < count; i++)
+            row_patterns[i] =
+                (unsigned char) BatchPatternRow (batch->a[first_row + i],
+                                                 batch->b[first_row + i],
+                                                 batch->c[first_row + i]);
+
+        PartitionRows (row_patterns, count, first_row, QUADRATIC_PATTERN_COUNT,
+                       indices, offsets);
+
+        for (size_t k = 0; k < QUADRATIC_PATTERN_COUNT; k++)
+            SolvePatternRows (batch, (quadratic_batch_pattern) k,
+                              indices + offsets[k], offsets[k + 1] - offsets[k]);
+    }
+
+    free (row_patterns);
+    free (indices);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+static void
+SortBatchRoots (quadratic_equation_batch* batch)
+{
+    for (size_t i = 0; i < batch->size; i++)
+        SortRootsPair (&batch->x1[i], &batch->x2[i]);
+}
+
+
+static inline void
+SortRootsPair (double* x1,
+               double* x2)
+{
+    const double first  = *x1;
+    const double second = *x2;
+    const bool   swap   = second < first;
+
+    *x1 = swap ? second : first;
+    *x2 = swap ? first  : second;
+}
+
+
+static inline bool
+IsIllConditioned (double a_coef,
+                  double b_coef,
+                  double c_coef,
+                  double threshold)
+{
+    const double b_square = b_coef * b_coef;
+    const double four_ac  = 4 * a_coef * c_coef;
+    const double bound    = threshold * b_square;
+
+    return fabs (b_square - four_ac) < bound ||
+           fabs (four_ac)            < bound;
+}
+
+
+static inline bool
+IsPolishedRow (double                          a_coef,
+               double                          b_coef,
+               double                          c_coef,
+               quadratic_equation_roots_number roots_number,
+               double                          threshold)
+{
+    return (roots_number == QUADRATIC_EQUATION_ONE_ROOT ||
+            roots_number == QUADRATIC_EQUATION_TWO_ROOTS) &&
+           CompareDoubles (a_coef, 0) != DOUBLES_CMP_EQUAL &&
+           IsIllConditioned (a_coef, b_coef, c_coef, threshold);
+}
+
+
+static quadratic_batch_status
+PolishBatchRoots (quadratic_equation_batch*      batch,
+                  const quadratic_batch_options* options)
+{
+    size_t* indices = malloc (batch->size * sizeof (size_t));
+    if (indices == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    size_t sub_size = 0;
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        const quadratic_equation_roots_number roots_number =
+            batch->roots_number[i];
+
+        indices[sub_size] = i;
+        sub_size += IsPolishedRow (batch->a[i], batch->b[i], batch->c[i],
+                                   roots_number, options->polish_threshold);
+    }
+
+    if (sub_size == 0)
+    {
+        free (indices);
+        return QUADRATIC_BATCH_SUCCESS;
+    }
+
+    double* sub_columns = malloc (5 * sub_size * sizeof (double));
+    if (sub_columns == NULL)
+    {
+        free (indices);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    double* sub_a  = sub_columns;
+    double* sub_b  = sub_columns +     sub_size;
+    double* sub_c  = sub_columns + 2 * sub_size;
+    double* sub_x1 = sub_columns + 3 * sub_size;
+    double* sub_x2 = sub_columns + 4 * sub_size;
+
+    for (size_t i = 0; i < sub_size; i++)
+    {
+        sub_a [i] = batch->a [indices[i]];
+        sub_b [i] = batch->b [indices[i]];
+        sub_c [i] = batch->c [indices[i]];
+        sub_x1[i] = batch->x1[indices[i]];
+        sub_x2[i] = batch->x2[indices[i]];
+    }
+
+    for (size_t iteration = 0; iteration < options->polish_iterations;
+                               iteration++)
+    {
+        for (size_t i = 0; i < sub_size; i++)
+        {
+            sub_x1[i] = HalleyStep (sub_a[i], sub_b[i], sub_c[i], sub_x1[i]);
+            sub_x2[i] = HalleyStep (sub_a[i], sub_b[i], sub_c[i], sub_x2[i]);
+        }
+    }
+
+    for (size_t i = 0; i < sub_size; i++)
+    {
+        batch->x1[indices[i]] = sub_x1[i];
+        batch->x2[indices[i]] = sub_x2[i];
+    }
+
+    free (sub_columns);
+    free (indices);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+static inline double
+EvaluateResidual (double a_coef,
+                  double b_coef,
+                  double c_coef,
+                  double x)
+{
+    return fma (fma (a_coef, x, b_coef), x, c_coef);
+}
+
+
+static inline double
+HalleyStep (double a_coef,
+            double b_coef,
+            double c_coef,
+            double x)
+{
+    const double residual   = EvaluateResidual (a_coef, b_coef, c_coef, x);
+    const double derivative = fma (2 * a_coef, x, b_coef);
+    const double denominator =
+        2 * derivative * derivative - 2 * a_coef * residual;
+
+    const double step = (fabs (denominator) > DBL_MIN) ?
+                        2 * residual * derivative / denominator : 0.0;
+
+    const double x_new = x - step;
+    const double residual_new =
+        EvaluateResidual (a_coef, b_coef, c_coef, x_new);
+
+    return (fabs (residual_new) < fabs (residual)) ? x_new : x;
+}
+
+
+static inline double
+RowResidual (double                          a_coef,
+             double                          b_coef,
+             double                          c_coef,
+             double                          x1,
+             double                          x2,
+             quadratic_equation_roots_number roots_number)
+{
+    const double first_residual  = RootResidual (a_coef, b_coef, c_coef, x1);
+    const double second_residual = RootResidual (a_coef, b_coef, c_coef, x2);
+
+    const double first  = (roots_number == QUADRATIC_EQUATION_ONE_ROOT ||
+                           roots_number == QUADRATIC_EQUATION_TWO_ROOTS) ?
+                          first_residual : 0;
+    const double second = (roots_number == QUADRATIC_EQUATION_TWO_ROOTS) ?
+                          second_residual : 0;
+
+    return (isnan (second) || second > first) ? second : first;
+}
+
+
+static inline double
+RootResidual (double a_coef,
+              double b_coef,
+              double c_coef,
+              double x)
+{
+    const double value = EvaluateResidual (a_coef, b_coef, c_coef, x);
+    const double scale = fma (fabs (a_coef) * x, x,
+                              fma (fabs (b_coef), fabs (x), fabs (c_coef)));
+
+    return fabs (value) / ((scale > 0) ? scale : 1);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,527 @@
+/**
+ * @file quadratic_equation_bench.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Throughput benchmark implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "quadratic_equation_bench.h"
+#include "quadratic_equation_check.h"
+#include "quadratic_equation_packed.h"
+#include "quadratic_equation_handle.h"
+#include "quadratic_equation_local.h"
+#include "monotonic_clock.h"
+
+
+
+#include <string.h>
+#include <unistd.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Default number of equations
+static const size_t BENCH_DEFAULT_ROWS = 1 << 22;
+
+/// @brief Default number of timed solves
+static const size_t BENCH_DEFAULT_REPEATS = 5;
+
+/// @brief Bytes read and written per equation
+static const size_t BENCH_ROW_BYTES =
+    5 * sizeof (double) + sizeof (quadratic_equation_roots_number);
+
+
+/**
+ * @brief Packing of the roots after the solve
+ */
+typedef
+enum bench_packing
+{
+    BENCH_PACKING_NONE   = 0,   ///< Roots columns only
+    BENCH_PACKING_DOUBLE = 1,   ///< PackedRootsEncode() of double roots
+    BENCH_PACKING_FLOAT  = 2    ///< PackedRootsEncode() of float roots
+}
+bench_packing;
+
+
+/**
+ * @brief Benchmark case
+ */
+typedef
+struct bench_case
+{
+    const char*   name;             ///< Name for the report
+    bool          numa_aware;       ///< Place and pin by NUMA nodes
+    bool          huge_pages;       ///< Advise huge pages
+    bool          classify_first;   ///< Batch solver option
+    bool          route_patterns;   ///< Batch solver option
+    bool          sort_roots;       ///< Batch solver option
+    bool          polish_roots;     ///< Batch solver option
+    bool          fast_division;    ///< Batch solver option
+    bench_packing packing;          ///< Packing of the roots, timed with the solve
+}
+bench_case;
+
+/// @brief Benchmark cases
+static const bench_case BENCH_CASES[] =
+{
+    {"parallel",               false, false, false, false, false, false, false, BENCH_PACKING_NONE},
+    {"parallel numa",          true,  false, false, false, false, false, false, BENCH_PACKING_NONE},
+    {"parallel numa hugepage", true,  true,  false, false, false, false, false, BENCH_PACKING_NONE},
+    {"classified",             false, false, true,  false, false, false, false, BENCH_PACKING_NONE},
+    {"routed",                 false, false, false, true,  false, false, false, BENCH_PACKING_NONE},
+    {"sorted",                 false, false, false, false, true,  false, false, BENCH_PACKING_NONE},
+    {"polished",               false, false, false, false, false, true,  false, BENCH_PACKING_NONE},
+    {"fast division",          false, false, false, false, false, false, true,  BENCH_PACKING_NONE},
+    {"packed",                 false, false, false, false, false, false, false, BENCH_PACKING_DOUBLE},
+    {"packed float",           false, false, false, false, false, false, false, BENCH_PACKING_FLOAT}
+};
+
+/// @brief Number of cases
+static const size_t BENCH_CASES_NUMBER =
+    sizeof (BENCH_CASES) / sizeof (BENCH_CASES[0]);
+
+
+/**
+ * @brief Single equation solver under the latency benchmark
+ *
+ * @param a_coef Coefficient before \f$ x^2 \f$
+ * @param b_coef Coefficient before \f$ x \f$
+ * @param c_coef Free coefficient
+ *
+ * @retval First root, so the solve is not optimized out
+ */
+typedef
+double (*bench_latency_solve) (double a_coef,
+                               double b_coef,
+                               double c_coef);
+
+
+/**
+ * @brief Latency benchmark case
+ */
+typedef
+struct bench_latency_case
+{
+    const char*         name;   ///< Name for the report
+    bench_latency_solve solve;  ///< Solver
+}
+bench_latency_case;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Runs one benchmark case
+ *
+ * @param current_case Pointer to the case
+ * @param options      Pointer to the benchmark options
+ * @param counters     Pointer to the open counters
+ * @param result       Pointer to the case result
+ *
+ * @retval Status @see quadratic_batch_status
+ */
+static quadratic_batch_status
+RunCase (const bench_case*              current_case,
+         const quadratic_bench_options* options,
+         perf_counters*                 counters,
+         quadratic_bench_result*        result);
+
+
+/**
+ * @brief Solves by SolveQuadraticEquation() with allocated coefficients
+ *
+ * @see bench_latency_solve
+ */
+static double
+SolveAllocated (double a_coef,
+                double b_coef,
+                double c_coef);
+
+
+/**
+ * @brief Solves by HandleInit() of a stack handle
+ *
+ * @see bench_latency_solve
+ */
+static double
+SolveStackHandle (double a_coef,
+                  double b_coef,
+                  double c_coef);
+
+
+/**
+ * @brief Solves by SolveQuadraticEquationLocal()
+ *
+ * @see bench_latency_solve
+ */
+static double
+SolveLocal (double a_coef,
+            double b_coef,
+            double c_coef);
+
+
+/**
+ * @brief Fills percentiles of the result from the sorted solve times
+ *
+ * @param times   Sorted solve times, nanoseconds
+ * @param samples Number of times
+ * @param result  Pointer to the result
+ */
+static void
+SetLatencyPercentiles (const uint64_t*           times,
+                       size_t                    samples,
+                       quadratic_latency_result* result);
+
+
+/**
+ * @brief Compares two solve times for qsort()
+ */
+static int
+CompareTimes (const void* first,
+              const void* second);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Benchmark interface implementation
+//------------------------------------------------------------------------------
+
+void
+BenchOptionsInit (quadratic_bench_options* options)
+{
+    if (options == NULL) return;
+
+    options->rows    = BENCH_DEFAULT_ROWS;
+    options->threads = 0;
+    options->repeats = BENCH_DEFAULT_REPEATS;
+    options->seed    = 1;
+}
+
+
+quadratic_batch_status
+BenchRun (const quadratic_bench_options* options,
+          quadratic_bench_report*        report)
+{
+    if (report == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    quadratic_bench_options default_options = {0};
+    if (options == NULL)
+    {
+        BenchOptionsInit (&default_options);
+        options = &default_options;
+    }
+
+    memset (report, 0, sizeof (quadratic_bench_report));
+
+    report->rows         = options->rows;
+    report->threads      = options->threads;
+    report->nodes_number = ParallelNumaNodesNumber ();
+
+    if (report->threads == 0)
+    {
+        long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+        report->threads = (cpus > 0) ? (size_t) cpus : 1;
+    }
+
+    perf_counters counters = {0};
+    PerfCountersOpen (&counters);
+
+    quadratic_batch_status status = QUADRATIC_BATCH_SUCCESS;
+
+    for (size_t i = 0; i < BENCH_CASES_NUMBER; i++)
+    {
+        status = RunCase (&BENCH_CASES[i], options, &counters,
+                          &report->cases[i]);
+        if (status != QUADRATIC_BATCH_SUCCESS) break;
+
+        report->cases[i].speedup = (report->cases[i].seconds > 0) ?
+                                   report->cases[0].seconds /
+                                   report->cases[i].seconds : 0;
+        report->cases_number++;
+    }
+
+    PerfCountersClose (&counters);
+
+    return status;
+}
+
+
+quadratic_batch_status
+BenchLatencyRun (const quadratic_bench_options* options,
+                 quadratic_latency_report*      report)
+{
+    if (report == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    quadratic_bench_options default_options = {0};
+    if (options == NULL)
+    {
+        BenchOptionsInit (&default_options);
+        options = &default_options;
+    }
+
+    memset (report, 0, sizeof (quadratic_latency_report));
+
+    const bench_latency_case cases[] =
+    {
+        {"SolveQuadraticEquation", SolveAllocated},
+        {"HandleInit",             SolveStackHandle},
+        {"thread-local",           SolveLocal}
+    };
+    const size_t cases_number = sizeof (cases) / sizeof (cases[0]);
+    const size_t samples      = options->rows;
+
+    quadratic_equation_batch* batch = BatchConstructor (samples);
+    uint64_t* times = calloc (cases_number * samples + 1, sizeof (uint64_t));
+
+    if (batch == NULL || times == NULL)
+    {
+        batch = BatchDestructor (batch);
+        free (times);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    CheckFillBatch (batch, options->seed);
+
+    volatile double sink = 0;
+
+    for (size_t i = 0; i < samples; i++)
+    {
+        for (size_t j = 0; j < cases_number; j++)
+        {
+            const uint64_t start = MonotonicNanoseconds ();
+            sink = cases[j].solve (batch->a[i], batch->b[i], batch->c[i]);
+            times[j * samples + i] = MonotonicNanoseconds () - start;
+        }
+    }
+
+    (void) sink;
+
+    report->samples      = samples;
+    report->cases_number = cases_number;
+
+    for (size_t j = 0; j < cases_number; j++)
+    {
+        qsort (times + j * samples, samples, sizeof (uint64_t), CompareTimes);
+
+        report->cases[j].name = cases[j].name;
+        SetLatencyPercentiles (times + j * samples, samples, &report->cases[j]);
+    }
+
+    batch = BatchDestructor (batch);
+    free (times);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+void
+BenchSetCounters (quadratic_bench_result*     result,
+                  const perf_counters_values* values,
+                  size_t                      rows)
+{
+    if (result == NULL || values == NULL) return;
+
+    result->has_counters = values->is_valid[PERF_COUNTER_CYCLES] &&
+                           values->is_valid[PERF_COUNTER_INSTRUCTIONS] &&
+                           values->values  [PERF_COUNTER_CYCLES] != 0;
+    if (!result->has_counters || rows == 0) return;
+
+    result->instructions_per_cycle =
+        (double) values->values[PERF_COUNTER_INSTRUCTIONS] /
+        (double) values->values[PERF_COUNTER_CYCLES];
+
+    result->branch_misses_per_row =
+        (double) values->values[PERF_COUNTER_BRANCH_MISSES] / (double) rows;
+    result->l1_misses_per_row =
+        (double) values->values[PERF_COUNTER_L1D_MISSES]    / (double) rows;
+    result->llc_misses_per_row =
+        (double) values->values[PERF_COUNTER_LLC_MISSES]    / (double) rows;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static quadratic_batch_status
+RunCase (const bench_case*              current_case,
+         const quadratic_bench_options* options,
+         perf_counters*                 counters,
+         quadratic_bench_result*        result)
+{
+    quadratic_parallel_options parallel_options = {0};
+    ParallelOptionsInit (&parallel_options);
+    parallel_options.threads              = options->threads;
+    parallel_options.numa_aware           = current_case->numa_aware;
+    parallel_options.huge_pages           = current_case->huge_pages;
+    parallel_options.solve.classify_first = current_case->classify_first;
+    parallel_options.solve.route_patterns = current_case->route_patterns;
+    parallel_options.solve.sort_roots     = current_case->sort_roots;
+    parallel_options.solve.polish_roots   = current_case->polish_roots;
+    parallel_options.solve.fast_division  = current_case->fast_division;
+
+    quadratic_equation_batch* batch = current_case->numa_aware ?
+        BatchParallelConstructor (options->rows, &parallel_options) :
+        BatchConstructor (options->rows);
+    if (batch == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    quadratic_packed_roots* packed = NULL;
+    if (current_case->packing != BENCH_PACKING_NONE)
+    {
+        packed = PackedRootsConstructor (options->rows,
+                     current_case->packing == BENCH_PACKING_FLOAT);
+        if (packed == NULL)
+        {
+            batch = BatchDestructor (batch);
+            return QUADRATIC_BATCH_ALLOC_ERROR;
+        }
+    }
+
+    CheckFillBatch (batch, options->seed);
+
+    quadratic_batch_status status =
+        SolveQuadraticBatchParallel (batch, &parallel_options);
+
+    double best_seconds = 0;
+    perf_counters_values values = {0};
+
+    PerfCountersStart (counters);
+
+    for (size_t i = 0; i < options->repeats &&
+                       status == QUADRATIC_BATCH_SUCCESS; i++)
+    {
+        const double start = MonotonicSeconds ();
+        status = SolveQuadraticBatchParallel (batch, &parallel_options);
+        if (packed != NULL && status == QUADRATIC_BATCH_SUCCESS)
+            status = PackedRootsEncode (packed, batch);
+        const double seconds = MonotonicSeconds () - start;
+
+        if (i == 0 || seconds < best_seconds) best_seconds = seconds;
+    }
+
+    PerfCountersStop (counters, &values);
+
+    const size_t packed_bytes = PackedRootsBytes (packed);
+
+    batch  = BatchDestructor (batch);
+    packed = PackedRootsDestructor (packed);
+    if (status != QUADRATIC_BATCH_SUCCESS) return status;
+
+    BenchSetCounters (result, &values, options->rows * options->repeats);
+
+    result->name    = current_case->name;
+    result->seconds = best_seconds;
+
+    if (best_seconds > 0)
+    {
+        result->rows_per_second  = (double) options->rows / best_seconds;
+        result->bytes_per_second =
+            (double) (options->rows * BENCH_ROW_BYTES + packed_bytes) /
+            best_seconds;
+    }
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+static double
+SolveAllocated (double a_coef,
+                double b_coef,
+                double c_coef)
+{
+    quadratic_equation_coefs* coefs = CoefsConstructor (a_coef, b_coef, c_coef);
+    if (coefs == NULL) return NAN;
+
+    quadratic_equation* equation = SolveQuadraticEquation (coefs);
+    if (equation == NULL)
+    {
+        coefs = CoefsDestructor (coefs);
+        return NAN;
+    }
+
+    const double x1 = equation->roots->x1;
+    equation = EndSolver (equation);
+
+    return x1;
+}
+
+
+static double
+SolveStackHandle (double a_coef,
+                  double b_coef,
+                  double c_coef)
+{
+    quadratic_equation_handle handle = {0};
+
+    return HandleInit (&handle, a_coef, b_coef, c_coef)->x1;
+}
+
+
+static double
+SolveLocal (double a_coef,
+            double b_coef,
+            double c_coef)
+{
+    return SolveQuadraticEquationLocal (a_coef, b_coef, c_coef)->x1;
+}
+
+
+static void
+SetLatencyPercentiles (const uint64_t*           times,
+                       size_t                    samples,
+                       quadratic_latency_result* result)
+{
+    if (samples == 0) return;
+
+    const double fractions[] = {0.5, 0.99, 0.999};
+    double*      percentiles[] = {&result->p50_ns, &result->p99_ns,
+                                  &result->p999_ns};
+
+    for (size_t i = 0; i < sizeof (fractions) / sizeof (fractions[0]); i++)
+    {
+        size_t index = (size_t) (fractions[i] * (double) samples);
+        if (index >= samples) index = samples - 1;
+
+        *percentiles[i] = (double) times[index];
+    }
+
+    result->max_ns = (double) times[samples - 1];
+}
+
+
+static int
+CompareTimes (const void* first,
+              const void* second)
+{
+    const uint64_t first_time  = *(const uint64_t*) first;
+    const uint64_t second_time = *(const uint64_t*) second;
+
+    return (first_time > second_time) - (first_time < second_time);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
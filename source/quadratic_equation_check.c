@@ -0,0 +1,2265 @@
+/**
+ * @file quadratic_equation_check.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Differential check implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#define _GNU_SOURCE
+
+
+
+#include "quadratic_equation_check.h"
+#include "quadratic_equation_parallel.h"
+#include "quadratic_equation_handle.h"
+#include "quadratic_equation_async.h"
+#include "quadratic_equation_packed.h"
+#include "quadratic_equation_runtime.h"
+#include "quadratic_equation_local.h"
+#include "doubles_compare.h"
+#include "csv_ingest.h"
+
+
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Values that break naive implementations
+static const double CHECK_SPECIAL_VALUES[] =
+{
+     0.0,            -0.0,
+     1.0,            -1.0,
+     2.0,             0.5,
+     DBL_EPSILON,    -DBL_EPSILON,
+     DBL_EPSILON * (1 - DBL_EPSILON / 2),
+     DBL_EPSILON * (1 + DBL_EPSILON),
+     DBL_MIN,        -DBL_MIN,
+     DBL_MIN / 4,    -DBL_MIN / 4,
+     DBL_MAX,        -DBL_MAX,
+     INFINITY,       -INFINITY,
+     NAN
+};
+
+/// @brief Number of special values
+static const size_t CHECK_SPECIAL_VALUES_NUMBER =
+    sizeof (CHECK_SPECIAL_VALUES) / sizeof (CHECK_SPECIAL_VALUES[0]);
+
+
+/// @brief Worker threads of the parallel variants
+static const size_t CHECK_PARALLEL_THREADS = 4;
+
+/// @brief Maximum rows of one request of the async variant
+static const size_t CHECK_ASYNC_MAX_REQUEST_ROWS = 300;
+
+/// @brief Maximum rows of one job of the runtime variant
+static const size_t CHECK_RUNTIME_MAX_JOB_ROWS = 5000;
+
+/// @brief Rows of one time slice of the runtime variant
+static const size_t CHECK_RUNTIME_SLICE_ROWS = 1024;
+
+/// @brief Tenants of the runtime variant
+static const size_t CHECK_RUNTIME_TENANTS_NUMBER = 3;
+
+/// @brief Interactive slices in a row of the runtime order variant
+static const size_t CHECK_RUNTIME_ORDER_BURST = 2;
+
+/**
+ * @brief Job of the runtime order variant
+ */
+typedef
+struct check_runtime_job
+{
+    size_t             tenant;      ///< Tenant of the job
+    quadratic_priority priority;    ///< Priority class of the job
+}
+check_runtime_job;
+
+/// @brief Jobs of the runtime order variant in submit order
+static const check_runtime_job CHECK_RUNTIME_ORDER_JOBS[] =
+{
+    {0, QUADRATIC_PRIORITY_BULK},
+    {0, QUADRATIC_PRIORITY_BULK},
+    {1, QUADRATIC_PRIORITY_BULK},
+    {0, QUADRATIC_PRIORITY_INTERACTIVE},
+    {0, QUADRATIC_PRIORITY_INTERACTIVE},
+    {1, QUADRATIC_PRIORITY_INTERACTIVE},
+    {2, QUADRATIC_PRIORITY_INTERACTIVE}
+};
+
+/// @brief Number of jobs of the runtime order variant
+#define CHECK_RUNTIME_ORDER_JOBS_NUMBER \
+    (sizeof (CHECK_RUNTIME_ORDER_JOBS) / sizeof (CHECK_RUNTIME_ORDER_JOBS[0]))
+
+/// @brief Expected completion order of the jobs of the runtime order variant
+///
+/// After the interactive gate job of tenant 0, interactive tenants 1 and 2
+/// take their turns, the burst of 2 lets the first bulk job of tenant 0 in,
+/// then the jobs of interactive tenant 0 in submit order, then bulk tenant 1
+/// and the second bulk job of tenant 0
+static const size_t CHECK_RUNTIME_ORDER_EXPECTED[CHECK_RUNTIME_ORDER_JOBS_NUMBER] =
+{
+    5, 6, 0, 3, 4, 2, 1
+};
+
+/// @brief Formats of the coefficients parsed by the number parsing variant,
+/// fast path and strtod() fallback ones, "%.1f" gives fields of any length
+static const char* const CHECK_NUMBER_FORMATS[] =
+{
+    "%.17g", "%.15g", "%.16e", "%.6g", "%.0f", "%.1f"
+};
+
+/// @brief Number of the formats of the number parsing variant
+static const size_t CHECK_NUMBER_FORMATS_NUMBER =
+    sizeof (CHECK_NUMBER_FORMATS) / sizeof (CHECK_NUMBER_FORMATS[0]);
+
+/// @brief Wrappers of the formatted coefficient, ignored by CsvParseNumber()
+static const char* const CHECK_NUMBER_WRAPPERS[] =
+{
+    "%s", "  %s ", "\"%s\""
+};
+
+/// @brief Number of the wrappers of the number parsing variant
+static const size_t CHECK_NUMBER_WRAPPERS_NUMBER =
+    sizeof (CHECK_NUMBER_WRAPPERS) / sizeof (CHECK_NUMBER_WRAPPERS[0]);
+
+/// @brief Length of the formatted coefficient, enough for "%.1f" of DBL_MAX
+enum { CHECK_NUMBER_LENGTH = 512 };
+
+/// @brief Step of the rows whose coefficients are written and parsed back,
+/// formatting every row would take most of the check time
+static const size_t CHECK_NUMBER_ROWS_STEP = 8;
+
+
+/// @brief Input size of the resumed CSV variant, one and a half ingest windows,
+/// so the interrupted run commits a checkpoint before its read fails
+static const size_t CHECK_RESUME_INPUT_SIZE = 3 << 23;
+
+/// @brief Input bytes between checkpoints of the resumed CSV variant,
+/// a checkpoint is committed after every window
+static const size_t CHECK_RESUME_CHECKPOINT_INTERVAL = 1;
+
+/// @brief Template of the checkpoint path of the resumed CSV variant
+static const char CHECK_RESUME_CHECKPOINT_TEMPLATE[] = "/tmp/quadratic_check_XXXXXX";
+
+/// @brief Messages for differential check
+static const char* const CHECK_PASSED_MESSAGE    = "All variants agree with the reference, rows:";
+static const char* const CHECK_DIVERGED_MESSAGE  = "Variant diverged from the reference:";
+static const char* const CHECK_INVARIANT_MESSAGE = "Broken invariant:";
+
+/// @brief Names of batch row classes
+static const char* const CHECK_CLASS_NAMES[] =
+{
+    "no roots", "one root", "two roots", "linear", "infinite roots", "invalid"
+};
+
+
+/// @brief Residual threshold of the verified variant
+static const double CHECK_VERIFY_THRESHOLD = 1e-12;
+
+
+/// @brief Invariant of the cancellable variant: a cancelled call solves nothing
+static const char* const CHECK_CANCELLED_INVARIANT =
+    "cancelled call must solve no rows";
+
+/// @brief Invariant of the cancellable variant: a live call solves all rows
+static const char* const CHECK_RESUMED_INVARIANT =
+    "resumed call must solve all its rows";
+
+/// @brief Invariant of the verified variant: flagged rows exceed the threshold
+static const char* const CHECK_FLAGGED_INVARIANT =
+    "row must be flagged iff its residual exceeds the threshold";
+
+/// @brief Invariant of the verified variant: the count matches the flags
+static const char* const CHECK_FLAGGED_COUNT_INVARIANT =
+    "flagged count must match the flagged rows";
+
+/// @brief Invariant of the number parsing variant: parsing matches strtod()
+static const char* const CHECK_PARSED_INVARIANT =
+    "CsvParseNumber() must give the strtod() value of every coefficient text";
+
+/// @brief Invariant of the CSV variants: the input is solved as a whole
+static const char* const CHECK_CSV_STATUS_INVARIANT =
+    "CsvSolveStream() must solve every row of the input";
+
+/// @brief Invariant of the CSV variants: the text output has a line per row
+static const char* const CHECK_CSV_TEXT_INVARIANT =
+    "CSV output must have roots_number, x1, x2 line of every row";
+
+/// @brief Invariant of the CSV stream variant: Arrow output matches the text one
+static const char* const CHECK_CSV_ARROW_INVARIANT =
+    "Arrow output must encode the roots of the CSV output";
+
+/// @brief Invariant of the resumed CSV variant: the interrupted run leaves a checkpoint
+static const char* const CHECK_CSV_CHECKPOINT_INVARIANT =
+    "CsvSolveStream() interrupted by a read error must leave a checkpoint";
+
+/// @brief Invariant of the resumed CSV variant: resuming does not change the output
+static const char* const CHECK_CSV_RESUME_INVARIANT =
+    "resumed CSV output must match the uninterrupted one";
+
+/// @brief Invariant of the placed variant: the constructor initializes every row
+static const char* const CHECK_PLACED_INVARIANT =
+    "placed batch must start with zero coefficients and unsolved rows";
+
+/// @brief Invariant of the runtime order variant: jobs complete in schedule order
+static const char* const CHECK_RUNTIME_ORDER_INVARIANT =
+    "single worker runtime must complete jobs by priority, burst and tenant turn";
+
+/// @brief Invariant of the runtime order variant: metrics count every job
+static const char* const CHECK_RUNTIME_METRICS_INVARIANT =
+    "runtime class metrics must count every submitted job and row";
+
+
+/**
+ * @brief Solvers under check
+ */
+typedef
+enum check_kernel
+{
+    CHECK_KERNEL_BATCH           = 0,   ///< SolveQuadraticBatch()
+    CHECK_KERNEL_PARALLEL        = 1,   ///< SolveQuadraticBatchParallel()
+    CHECK_KERNEL_DIRTY           = 2,   ///< SolveQuadraticBatchDirty() over changed rows
+    CHECK_KERNEL_HANDLE          = 3,   ///< HandleUpdateA(), HandleUpdateB(), HandleUpdateC()
+    CHECK_KERNEL_ASYNC           = 4,   ///< AsyncSubmit() of many small requests
+    CHECK_KERNEL_PACKED          = 5,   ///< PackedRootsEncode() and decode of the roots
+    CHECK_KERNEL_CANCEL          = 6,   ///< SolveQuadraticBatchCancellable() resumed after cancel
+    CHECK_KERNEL_PARALLEL_CANCEL = 7,   ///< SolveQuadraticBatchParallelCancellable()
+    CHECK_KERNEL_RUNTIME         = 8,   ///< RuntimeSubmit() of jobs of several tenants
+    CHECK_KERNEL_LOCAL           = 9,   ///< SolveQuadraticEquationLocal() of every row
+    CHECK_KERNEL_VERIFIED        = 10,  ///< SolveQuadraticBatchVerified() with residuals
+    CHECK_KERNEL_RUNTIME_ORDER   = 11,  ///< RuntimeSubmit() to a single worker
+    CHECK_KERNEL_PARALLEL_PLACED = 12,  ///< SolveQuadraticBatchParallel() of BatchParallelConstructor()
+    CHECK_KERNEL_CSV_NUMBERS     = 13,  ///< CsvParseNumber() of formatted coefficients
+    CHECK_KERNEL_CSV_STREAM      = 14,  ///< CsvSolveStream() to text and Arrow output
+    CHECK_KERNEL_CSV_RESUME      = 15   ///< CsvSolveStream() interrupted and resumed
+}
+check_kernel;
+
+
+/**
+ * @brief Batch solver variant under check
+ */
+typedef
+struct check_variant
+{
+    const char*  name;              ///< Name for the report
+    check_kernel kernel;            ///< Solver of the variant
+    bool         classify_first;    ///< Option of the variant
+    bool         polish_roots;      ///< Option of the variant, residuals of roots are compared
+    bool         route_patterns;    ///< Option of the variant
+    bool         sort_roots;        ///< Option of the variant, reference roots are sorted
+    bool         fast_division;     ///< Option of the variant
+    bool         numa_aware;        ///< Option of the parallel variants
+    bool         float_roots;       ///< Roots are stored as float, reference roots are rounded
+    uint64_t     max_ulp_error;     ///< Allowed ULP distance from the reference
+}
+check_variant;
+
+
+/**
+ * @brief Invariant broken by a variant besides the roots
+ */
+typedef
+struct check_invariant
+{
+    const char* message;    ///< Broken invariant, NULL if all invariants hold
+    size_t      row;        ///< Row where the invariant is broken
+}
+check_invariant;
+
+
+/**
+ * @brief Input of the interrupted run of the resumed CSV variant
+ */
+typedef
+struct check_failing_input
+{
+    FILE* file;     ///< Underlying seekable file
+    off_t limit;    ///< Offset where reads start to fail
+}
+check_failing_input;
+
+
+/**
+ * @brief Completion log of the runtime order variant
+ */
+typedef
+struct check_runtime_order
+{
+    pthread_mutex_t              lock;          ///< Guard of the gate
+    pthread_cond_t               changed;       ///< Gate is entered or opened
+    bool                         is_entered;    ///< Worker is held by the gate
+    bool                         is_open;       ///< Worker may go on
+    const quadratic_runtime_job* jobs;          ///< Jobs in submit order
+    size_t completed[CHECK_RUNTIME_ORDER_JOBS_NUMBER];  ///< Jobs by completion
+    size_t                       completed_number;      ///< Completed jobs
+}
+check_runtime_order;
+
+/// @brief Batch solver variants under check
+static const check_variant CHECK_VARIANTS[] =
+{
+    {"batch",                      CHECK_KERNEL_BATCH,           false, false, false, false, false, false, false, 0},
+    {"batch classified",           CHECK_KERNEL_BATCH,           true,  false, false, false, false, false, false, 0},
+    {"batch polished",             CHECK_KERNEL_BATCH,           false, true,  false, false, false, false, false, 0},
+    {"batch classified polished",  CHECK_KERNEL_BATCH,           true,  true,  false, false, false, false, false, 0},
+    {"batch routed",               CHECK_KERNEL_BATCH,           false, false, true,  false, false, false, false, 0},
+    {"batch sorted",               CHECK_KERNEL_BATCH,           false, false, false, true,  false, false, false, 0},
+    {"batch fast division",        CHECK_KERNEL_BATCH,           false, false, false, false, true,  false, false, 2},
+    {"batch parallel",             CHECK_KERNEL_PARALLEL,        false, false, false, false, false, true,  false, 0},
+    {"batch parallel classified",  CHECK_KERNEL_PARALLEL,        true,  false, false, false, false, true,  false, 0},
+    {"batch parallel unpinned",    CHECK_KERNEL_PARALLEL,        false, false, false, false, false, false, false, 0},
+    {"batch parallel placed",      CHECK_KERNEL_PARALLEL_PLACED, false, false, false, false, false, true,  false, 0},
+    {"batch dirty rows",           CHECK_KERNEL_DIRTY,           false, false, false, false, false, false, false, 0},
+    {"batch dirty rows polished",  CHECK_KERNEL_DIRTY,           false, true,  false, false, false, false, false, 0},
+    {"batch dirty rows sorted",    CHECK_KERNEL_DIRTY,           false, false, false, true,  false, false, false, 0},
+    {"batch dirty rows fast",      CHECK_KERNEL_DIRTY,           false, false, false, false, true,  false, false, 2},
+    {"incremental handle",         CHECK_KERNEL_HANDLE,          false, false, false, false, false, false, false, 0},
+    {"async coalesced",            CHECK_KERNEL_ASYNC,           false, false, false, false, false, false, false, 0},
+    {"packed roots",               CHECK_KERNEL_PACKED,          false, false, false, false, false, false, false, 0},
+    {"packed roots float",         CHECK_KERNEL_PACKED,          false, false, false, false, false, false, true,  0},
+    {"batch cancellable",          CHECK_KERNEL_CANCEL,          false, false, false, false, false, false, false, 0},
+    {"batch parallel cancellable", CHECK_KERNEL_PARALLEL_CANCEL, false, false, false, false, false, true,  false, 0},
+    {"runtime scheduled",          CHECK_KERNEL_RUNTIME,         false, false, false, false, false, false, false, 0},
+    {"thread-local single",        CHECK_KERNEL_LOCAL,           false, false, false, false, false, false, false, 0},
+    {"batch verified",             CHECK_KERNEL_VERIFIED,        false, false, false, false, false, false, false, 0},
+    {"runtime single worker",      CHECK_KERNEL_RUNTIME_ORDER,   false, false, false, false, false, false, false, 0},
+    {"csv parsed numbers",         CHECK_KERNEL_CSV_NUMBERS,     false, false, false, false, false, false, false, 0},
+    {"csv text and arrow",         CHECK_KERNEL_CSV_STREAM,      false, false, false, false, false, false, false, 0},
+    {"csv resumed checkpoint",     CHECK_KERNEL_CSV_RESUME,      false, false, false, false, false, false, false, 0}
+};
+
+/// @brief Number of variants
+static const size_t CHECK_VARIANTS_NUMBER =
+    sizeof (CHECK_VARIANTS) / sizeof (CHECK_VARIANTS[0]);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief xorshift64* generator step
+ *
+ * @param state Pointer to the generator state, must not be zero
+ *
+ * @retval Next random number
+ */
+static inline uint64_t
+NextRandom (uint64_t* state);
+
+
+/**
+ * @brief Generates random coefficient
+ *
+ * @param state Pointer to the generator state
+ *
+ * @retval Special value with probability 1/4,
+ * random double of exponent from -64 to 64 otherwise
+ */
+static double
+RandomCoef (uint64_t* state);
+
+
+/**
+ * @brief Solves one row by the scalar reference solver
+ */
+static void
+SolveReferenceRow (double  a_coef,
+                   double  b_coef,
+                   double  c_coef,
+                   double* x1,
+                   double* x2,
+                   quadratic_equation_roots_number* roots_number);
+
+
+/**
+ * @brief Finds the class of the row from the reference solution
+ *
+ * @param a_coef       Coefficient before \f$ x^2 \f$
+ * @param roots_number Roots number given by the reference solver
+ *
+ * @retval Class of the row, one root is linear if the reference solver
+ * takes a for zero, so BatchClassifyRow() under check is not used
+ */
+static quadratic_batch_class
+ReferenceRowClass (double                          a_coef,
+                   quadratic_equation_roots_number roots_number);
+
+
+/**
+ * @brief Rounds the reference root as the float packed encoding does
+ *
+ * @param root Reference root
+ *
+ * @retval The nearest float as double, infinity of the root sign
+ * if the root is above FLT_MAX in magnitude
+ */
+static double
+RoundRootToFloat (double root);
+
+
+/**
+ * @brief Checks the root of the variant against the reference one
+ *
+ * @param variant  Pointer to the variant
+ * @param a_coef   Coefficient before \f$ x^2 \f$
+ * @param b_coef   Coefficient before \f$ x \f$
+ * @param c_coef   Free coefficient
+ * @param actual   Root of the variant
+ * @param expected Reference root
+ *
+ * @retval true if the roots are within variant->max_ulp_error,
+ * or the variant polishes roots and the residual of its root
+ * is not above the reference one
+ */
+static bool
+IsRootAccepted (const check_variant* variant,
+                double               a_coef,
+                double               b_coef,
+                double               c_coef,
+                double               actual,
+                double               expected);
+
+
+/**
+ * @brief Finds the residual of the root as the polishing stage does
+ *
+ * @retval \f$ |ax^2 + bx + c| \f$ by Horner scheme with FMA
+ */
+static double
+RootResidual (double a_coef,
+              double b_coef,
+              double c_coef,
+              double x);
+
+
+/**
+ * @brief Solves the batch by the variant under check
+ *
+ * @param batch   Pointer to the batch
+ * @param variant Pointer to the variant
+ * @param broken  Pointer to the broken invariant of the variant
+ *
+ * @retval Status @see quadratic_batch_status
+ */
+static quadratic_batch_status
+SolveVariant (quadratic_equation_batch* batch,
+              const check_variant*      variant,
+              check_invariant*          broken);
+
+
+/**
+ * @brief Solves the batch, changes every other row and re-solves only them
+ *
+ * @param batch   Pointer to the batch
+ * @param options Pointer to the options of both solves
+ *
+ * @retval Status @see quadratic_batch_status
+ */
+static quadratic_batch_status
+SolveDirtyRows (quadratic_equation_batch*      batch,
+                const quadratic_batch_options* options);
+
+
+/**
+ * @brief Solves every row by a handle updated from other coefficients
+ *
+ * @param batch Pointer to the batch
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Rows in turn change a, b or c of the solved handle,
+ * so every update function is checked
+ */
+static quadratic_batch_status
+SolveHandleRows (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Solves the batch as many small requests to the worker pool
+ *
+ * @param batch Pointer to the batch
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Requests of different sizes are submitted at once,
+ * so the workers coalesce them
+ */
+static quadratic_batch_status
+SolveAsyncRows (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Solves the batch and replaces the roots by packed and unpacked ones
+ *
+ * @param batch    Pointer to the batch
+ * @param is_float Pack the roots as float
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Odd rows are unpacked by PackedRootsGet(),
+ * the others by PackedRootsDecode()
+ */
+static quadratic_batch_status
+SolvePackedRows (quadratic_equation_batch* batch,
+                 bool                      is_float);
+
+
+/**
+ * @brief Solves the batch by a cancelled call and a resuming one
+ *
+ * @param batch  Pointer to the batch
+ * @param broken Pointer to the broken invariant
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details The first call gets a cancelled token and must solve nothing,
+ * the second one solves the rows from the middle of the batch,
+ * then the first half is solved with a live token
+ * If a call solves other rows, the invariant is recorded in broken
+ * and the batch is still solved to the end
+ */
+static quadratic_batch_status
+SolveCancelledRows (quadratic_equation_batch* batch,
+                    check_invariant*          broken);
+
+
+/**
+ * @brief Solves a copy of the batch placed by BatchParallelConstructor()
+ *
+ * @param batch   Pointer to the batch
+ * @param options Pointer to the options of the placement and the solve
+ * @param broken  Pointer to the broken invariant
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details If a row of the placed batch is not initialized before the copy,
+ * the invariant is recorded in broken
+ */
+static quadratic_batch_status
+SolvePlacedRows (quadratic_equation_batch*         batch,
+                 const quadratic_parallel_options* options,
+                 check_invariant*                  broken);
+
+
+/**
+ * @brief Solves the batch as jobs of the shared solver runtime
+ *
+ * @param batch Pointer to the batch
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Jobs of different sizes, tenants and priorities are submitted
+ * at once, so the slices of the jobs interleave
+ */
+static quadratic_batch_status
+SolveRuntimeRows (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Solves every row by the low latency single equation solver
+ *
+ * @param batch Pointer to the batch
+ *
+ * @retval QUADRATIC_BATCH_SUCCESS
+ */
+static quadratic_batch_status
+SolveLocalRows (quadratic_equation_batch* batch);
+
+
+/**
+ * @brief Solves the batch with the residuals stage
+ *
+ * @param batch  Pointer to the batch
+ * @param broken Pointer to the broken invariant
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details If the flagged rows, their count and the residuals disagree,
+ * the invariant is recorded in broken
+ */
+static quadratic_batch_status
+SolveVerifiedRows (quadratic_equation_batch* batch,
+                   check_invariant*          broken);
+
+
+/**
+ * @brief Solves the batch parsed back from the texts of its coefficients
+ *
+ * @param batch  Pointer to the batch
+ * @param broken Pointer to the broken invariant
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details Every coefficient of every CHECK_NUMBER_ROWS_STEP row,
+ * the others are solved as they are, is written as "%.17g" and by one more of
+ * CHECK_NUMBER_FORMATS inside one of CHECK_NUMBER_WRAPPERS (they take turns
+ * by rows) and parsed by CsvParseNumber()
+ * If the value differs from the strtod() one of the unwrapped text
+ * (NaN if strtod() does not take the whole text), the invariant is recorded
+ * in broken; the coefficients parsed from "%.17g" texts are solved
+ */
+static quadratic_batch_status
+SolveParsedRows (quadratic_equation_batch* batch,
+                 check_invariant*          broken);
+
+
+/**
+ * @brief Parses the coefficient by CsvParseNumber() and checks it by strtod()
+ *
+ * @param value  Coefficient
+ * @param row    Row of the coefficient, selects the format and the wrapper
+ * @param parsed Pointer to the coefficient parsed from the "%.17g" text
+ *
+ * @retval true if the texts of the coefficient are parsed as strtod() does
+ */
+static bool
+ParseCoefTexts (double  value,
+                size_t  row,
+                double* parsed);
+
+
+/**
+ * @brief Compares doubles bit to bit, any NaN is equal to any NaN
+ */
+static bool
+IsSameDouble (double x,
+              double y);
+
+
+/**
+ * @brief Solves the batch written as CSV by CsvSolveStream()
+ *        to text and to Arrow output
+ *
+ * @param batch  Pointer to the batch
+ * @param broken Pointer to the broken invariant
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details The coefficients are written as "%.17g", both runs use
+ * a single parsing thread, so the input (less than an ingest window)
+ * is one chunk and the Arrow output is the schema, one record batch
+ * and the end of stream
+ * The roots are parsed back from the text output, if the Arrow output
+ * differs from the one encoded from them, the invariant is recorded
+ * in broken
+ */
+static quadratic_batch_status
+SolveCsvStreamRows (quadratic_equation_batch* batch,
+                    check_invariant*          broken);
+
+
+/**
+ * @brief Solves the batch by CsvSolveStream() interrupted by a read error
+ *        and resumed from its checkpoint
+ *
+ * @param batch  Pointer to the batch
+ * @param broken Pointer to the broken invariant
+ *
+ * @details The rows are padded up to CHECK_RESUME_INPUT_SIZE input,
+ * the interrupted run commits a checkpoint after every window
+ * and its reads fail after three quarters of the input
+ * If no checkpoint is left or the resumed output differs from
+ * the uninterrupted one, the invariant is recorded in broken
+ */
+static quadratic_batch_status
+SolveCsvResumedRows (quadratic_equation_batch* batch,
+                     check_invariant*          broken);
+
+
+/**
+ * @brief Reads the underlying file until the limit offset
+ *
+ * @retval Number of read bytes
+ * @retval -1 with EIO errno past the limit
+ */
+static ssize_t
+ReadFailingInput (void*  input_ptr,
+                  char*  buffer,
+                  size_t size);
+
+
+/**
+ * @brief Seeks the underlying file
+ *
+ * @retval 0 on success, -1 otherwise
+ */
+static int
+SeekFailingInput (void*    input_ptr,
+                  off64_t* offset,
+                  int      whence);
+
+
+/**
+ * @brief Writes the coefficients as CSV with a header to a temporary file
+ *
+ * @param batch   Pointer to the batch
+ * @param padding Length of the padding column after the coefficients,
+ *                0 for no padding column
+ *
+ * @retval Temporary file rewound to its start
+ * @retval NULL if the file can not be created or written
+ */
+static FILE*
+WriteCsvInput (const quadratic_equation_batch* batch,
+               size_t                          padding);
+
+
+/**
+ * @brief Reads the whole stream from its start
+ *
+ * @param stream Stream
+ * @param size   Pointer to the size of the content
+ *
+ * @retval Content of the stream, must be freed
+ * @retval NULL if the stream can not be read or allocation failed
+ */
+static char*
+ReadStream (FILE*   stream,
+            size_t* size);
+
+
+/**
+ * @brief Parses the roots of the CSV output (header, then roots_number,
+ *        x1, x2 lines without key) into the batch
+ *
+ * @param text   Output text
+ * @param size   Size of the text
+ * @param batch  Pointer to the batch
+ * @param broken Pointer to the broken invariant
+ *
+ * @details Empty roots are NaN, if some row has no valid line,
+ * the invariant is recorded in broken
+ */
+static void
+ParseCsvRoots (const char*               text,
+               size_t                    size,
+               quadratic_equation_batch* batch,
+               check_invariant*          broken);
+
+
+/**
+ * @brief Solves the batch as jobs of a single worker runtime
+ *
+ * @param batch  Pointer to the batch
+ * @param broken Pointer to the broken invariant
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details The worker is held by the callback of a gate job
+ * until every job of CHECK_RUNTIME_ORDER_JOBS is submitted,
+ * so the completion order is deterministic
+ * If it differs from CHECK_RUNTIME_ORDER_EXPECTED or the class metrics
+ * miss some job or row, the invariant is recorded in broken
+ */
+static quadratic_batch_status
+SolveRuntimeOrderRows (quadratic_equation_batch* batch,
+                       check_invariant*          broken);
+
+
+/**
+ * @brief Holds the worker until the gate is opened
+ *
+ * @param job       Pointer to the gate job
+ * @param order_ptr Pointer to the completion log
+ */
+static void
+HoldRuntimeGate (quadratic_runtime_job* job,
+                 void*                  order_ptr);
+
+
+/**
+ * @brief Appends the job to the completion log
+ *
+ * @param job       Pointer to the completed job
+ * @param order_ptr Pointer to the completion log
+ */
+static void
+LogRuntimeCompletion (quadratic_runtime_job* job,
+                      void*                  order_ptr);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Differential check interface implementation
+//------------------------------------------------------------------------------
+
+void
+CheckFillBatch (quadratic_equation_batch* batch,
+                uint64_t                  seed)
+{
+    if (batch == NULL) return;
+
+    uint64_t state = seed * 2 + 1;
+
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        batch->a[i] = RandomCoef (&state);
+        batch->b[i] = RandomCoef (&state);
+
+        if (NextRandom (&state) % 4 == 0 && isfinite (batch->a[i]) &&
+            fabs (batch->a[i]) > DBL_MIN)
+            batch->c[i] = batch->b[i] * batch->b[i] / 4 / batch->a[i] *
+                          (1 + ((double) (NextRandom (&state) % 5) - 2) *
+                               DBL_EPSILON);
+        else
+            batch->c[i] = RandomCoef (&state);
+    }
+}
+
+
+quadratic_batch_status
+CheckBatchVariants (quadratic_equation_batch* batch,
+                    quadratic_check_report*   report)
+{
+    if (batch == NULL || report == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    memset (report, 0, sizeof (quadratic_check_report));
+
+    quadratic_equation_batch* reference = BatchConstructor (batch->size);
+    if (reference == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    for (size_t i = 0; i < batch->size; i++)
+        SolveReferenceRow (batch->a[i], batch->b[i], batch->c[i],
+                           &reference->x1[i], &reference->x2[i],
+                           &reference->roots_number[i]);
+
+    for (size_t v = 0; v < CHECK_VARIANTS_NUMBER; v++)
+    {
+        const check_variant* variant = &CHECK_VARIANTS[v];
+
+        check_invariant broken = {0};
+
+        quadratic_batch_status status = SolveVariant (batch, variant, &broken);
+        if (status != QUADRATIC_BATCH_SUCCESS)
+        {
+            reference = BatchDestructor (reference);
+            return status;
+        }
+
+        for (size_t i = 0; i < batch->size; i++)
+        {
+            double expected_x1 = reference->x1[i];
+            double expected_x2 = reference->x2[i];
+
+            if (variant->sort_roots && expected_x2 < expected_x1)
+            {
+                expected_x1 = reference->x2[i];
+                expected_x2 = reference->x1[i];
+            }
+
+            if (variant->float_roots)
+            {
+                expected_x1 = RoundRootToFloat (expected_x1);
+                expected_x2 = RoundRootToFloat (expected_x2);
+            }
+
+            uint64_t ulp_error =
+                UlpDistance (batch->x1[i], expected_x1);
+            uint64_t ulp_error_x2 =
+                UlpDistance (batch->x2[i], expected_x2);
+            if (ulp_error_x2 > ulp_error) ulp_error = ulp_error_x2;
+
+            if ((broken.message == NULL || broken.row != i) &&
+                batch->roots_number[i] == reference->roots_number[i] &&
+                IsRootAccepted (variant, batch->a[i], batch->b[i], batch->c[i],
+                                batch->x1[i], expected_x1) &&
+                IsRootAccepted (variant, batch->a[i], batch->b[i], batch->c[i],
+                                batch->x2[i], expected_x2))
+                continue;
+
+            report->diverged        = true;
+            report->variant         = variant->name;
+            report->row             = i;
+            report->a               = batch->a[i];
+            report->b               = batch->b[i];
+            report->c               = batch->c[i];
+            report->row_class       =
+                ReferenceRowClass (batch->a[i], reference->roots_number[i]);
+            report->expected_number = reference->roots_number[i];
+            report->actual_number   = batch->roots_number[i];
+            report->expected_x1     = expected_x1;
+            report->expected_x2     = expected_x2;
+            report->actual_x1       = batch->x1[i];
+            report->actual_x2       = batch->x2[i];
+            report->ulp_error       = ulp_error;
+            report->invariant       = broken.message;
+
+            reference = BatchDestructor (reference);
+            return QUADRATIC_BATCH_SUCCESS;
+        }
+    }
+
+    report->rows_checked = batch->size;
+
+    reference = BatchDestructor (reference);
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_batch_status
+CheckRawInput (const uint8_t*          data,
+               size_t                  size,
+               quadratic_check_report* report)
+{
+    if (data == NULL || report == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    const size_t row_size = 3 * sizeof (double);
+    const size_t rows     = size / row_size;
+
+    memset (report, 0, sizeof (quadratic_check_report));
+    if (rows == 0) return QUADRATIC_BATCH_SUCCESS;
+
+    quadratic_equation_batch* batch = BatchConstructor (rows);
+    if (batch == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        const uint8_t* row = data + i * row_size;
+
+        memcpy (&batch->a[i], row,                      sizeof (double));
+        memcpy (&batch->b[i], row +     sizeof (double), sizeof (double));
+        memcpy (&batch->c[i], row + 2 * sizeof (double), sizeof (double));
+    }
+
+    quadratic_batch_status status = CheckBatchVariants (batch, report);
+
+    batch = BatchDestructor (batch);
+    return status;
+}
+
+
+uint64_t
+UlpDistance (double x,
+             double y)
+{
+    if (isnan (x) && isnan (y)) return 0;
+    if (isnan (x) || isnan (y)) return UINT64_MAX;
+
+    int64_t x_bits = 0;
+    int64_t y_bits = 0;
+    memcpy (&x_bits, &x, sizeof (double));
+    memcpy (&y_bits, &y, sizeof (double));
+
+    if (x_bits < 0) x_bits = INT64_MIN - x_bits;
+    if (y_bits < 0) y_bits = INT64_MIN - y_bits;
+
+    return (x_bits > y_bits) ? (uint64_t) x_bits - (uint64_t) y_bits :
+                               (uint64_t) y_bits - (uint64_t) x_bits;
+}
+
+
+void
+PrintCheckReport (const quadratic_check_report* report)
+{
+    if (report == NULL) return;
+
+    if (!report->diverged)
+    {
+        printf ("%s %zu\n", CHECK_PASSED_MESSAGE, report->rows_checked);
+        return;
+    }
+
+    const char* class_name = (report->row_class < QUADRATIC_CLASS_COUNT) ?
+                             CHECK_CLASS_NAMES[report->row_class] : "unknown";
+
+    printf ("%s %s\n"
+            "row %zu: a = %.17g, b = %.17g, c = %.17g, class: %s\n"
+            "expected %d roots: %.17g %.17g\n"
+            "actual   %d roots: %.17g %.17g\n"
+            "ULP error: %llu\n",
+            CHECK_DIVERGED_MESSAGE, report->variant,
+            report->row, report->a, report->b, report->c, class_name,
+            (int) report->expected_number,
+            report->expected_x1, report->expected_x2,
+            (int) report->actual_number,
+            report->actual_x1, report->actual_x2,
+            (unsigned long long) report->ulp_error);
+
+    if (report->invariant != NULL)
+        printf ("%s %s\n", CHECK_INVARIANT_MESSAGE, report->invariant);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static inline uint64_t
+NextRandom (uint64_t* state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+
+static double
+RandomCoef (uint64_t* state)
+{
+    const uint64_t random = NextRandom (state);
+
+    if (random % 4 == 0)
+        return CHECK_SPECIAL_VALUES[(random >> 2) %
+                                    CHECK_SPECIAL_VALUES_NUMBER];
+
+    const double mantissa = (double) (NextRandom (state) >> 11) /
+                            (double) (1ULL << 53);
+    const int    exponent = (int) ((random >> 2) % 129) - 64;
+    const double sign     = ((random >> 10) & 1) ? -1.0 : 1.0;
+
+    return sign * ldexp (mantissa, exponent);
+}
+
+
+static void
+SolveReferenceRow (double  a_coef,
+                   double  b_coef,
+                   double  c_coef,
+                   double* x1,
+                   double* x2,
+                   quadratic_equation_roots_number* roots_number)
+{
+    *x1 = NAN;
+    *x2 = NAN;
+    *roots_number = QUADRATIC_EQUATION_NOT_SOLVED;
+
+    quadratic_equation_coefs* coefs =
+        CoefsConstructor (a_coef, b_coef, c_coef);
+    if (coefs == NULL) return;
+
+    quadratic_equation* equation = SolveQuadraticEquation (coefs);
+    if (equation == NULL)
+    {
+        coefs = CoefsDestructor (coefs);
+        return;
+    }
+
+    *x1 = equation->roots->x1;
+    *x2 = equation->roots->x2;
+    *roots_number = equation->roots->roots_number;
+
+    equation = EndSolver (equation);
+}
+
+
+static quadratic_batch_class
+ReferenceRowClass (double                          a_coef,
+                   quadratic_equation_roots_number roots_number)
+{
+    switch (roots_number)
+    {
+        case QUADRATIC_EQUATION_NO_ROOTS:
+            return QUADRATIC_CLASS_NO_ROOTS;
+
+        case QUADRATIC_EQUATION_ONE_ROOT:
+            return (CompareDoubles (a_coef, 0) == DOUBLES_CMP_EQUAL) ?
+                   QUADRATIC_CLASS_LINEAR : QUADRATIC_CLASS_ONE_ROOT;
+
+        case QUADRATIC_EQUATION_TWO_ROOTS:
+            return QUADRATIC_CLASS_TWO_ROOTS;
+
+        case QUADRATIC_EQUATION_INF_ROOTS:
+            return QUADRATIC_CLASS_INF_ROOTS;
+
+        case QUADRATIC_EQUATION_NOT_SOLVED:
+        #if __STDC_VERSION__ >= 202300L
+            [[fallthrough]];
+        #endif
+
+        default:
+            return QUADRATIC_CLASS_INVALID;
+    }
+}
+
+
+static double
+RoundRootToFloat (double root)
+{
+    if (fabs (root) > FLT_MAX) return copysign (INFINITY, root);
+
+    return (double) (float) root;
+}
+
+
+static bool
+IsRootAccepted (const check_variant* variant,
+                double               a_coef,
+                double               b_coef,
+                double               c_coef,
+                double               actual,
+                double               expected)
+{
+    if (UlpDistance (actual, expected) <= variant->max_ulp_error) return true;
+
+    return variant->polish_roots &&
+           RootResidual (a_coef, b_coef, c_coef, actual) <=
+           RootResidual (a_coef, b_coef, c_coef, expected);
+}
+
+
+static double
+RootResidual (double a_coef,
+              double b_coef,
+              double c_coef,
+              double x)
+{
+    return fabs (fma (fma (a_coef, x, b_coef), x, c_coef));
+}
+
+
+static quadratic_batch_status
+SolveVariant (quadratic_equation_batch* batch,
+              const check_variant*      variant,
+              check_invariant*          broken)
+{
+    broken->message = NULL;
+    broken->row     = 0;
+
+    quadratic_parallel_options options = {0};
+    ParallelOptionsInit (&options);
+    options.threads              = CHECK_PARALLEL_THREADS;
+    options.numa_aware           = variant->numa_aware;
+    options.solve.classify_first = variant->classify_first;
+    options.solve.polish_roots   = variant->polish_roots;
+    options.solve.route_patterns = variant->route_patterns;
+    options.solve.sort_roots     = variant->sort_roots;
+    options.solve.fast_division  = variant->fast_division;
+
+    switch (variant->kernel)
+    {
+        case CHECK_KERNEL_BATCH:
+            return SolveQuadraticBatch (batch, &options.solve);
+
+        case CHECK_KERNEL_PARALLEL:
+            return SolveQuadraticBatchParallel (batch, &options);
+
+        case CHECK_KERNEL_DIRTY:
+            return SolveDirtyRows (batch, &options.solve);
+
+        case CHECK_KERNEL_HANDLE:
+            return SolveHandleRows (batch);
+
+        case CHECK_KERNEL_ASYNC:
+            return SolveAsyncRows (batch);
+
+        case CHECK_KERNEL_PACKED:
+            return SolvePackedRows (batch, variant->float_roots);
+
+        case CHECK_KERNEL_CANCEL:
+            return SolveCancelledRows (batch, broken);
+
+        case CHECK_KERNEL_RUNTIME:
+            return SolveRuntimeRows (batch);
+
+        case CHECK_KERNEL_LOCAL:
+            return SolveLocalRows (batch);
+
+        case CHECK_KERNEL_VERIFIED:
+            return SolveVerifiedRows (batch, broken);
+
+        case CHECK_KERNEL_RUNTIME_ORDER:
+            return SolveRuntimeOrderRows (batch, broken);
+
+        case CHECK_KERNEL_PARALLEL_PLACED:
+            return SolvePlacedRows (batch, &options, broken);
+
+        case CHECK_KERNEL_CSV_NUMBERS:
+            return SolveParsedRows (batch, broken);
+
+        case CHECK_KERNEL_CSV_STREAM:
+            return SolveCsvStreamRows (batch, broken);
+
+        case CHECK_KERNEL_CSV_RESUME:
+            return SolveCsvResumedRows (batch, broken);
+
+        case CHECK_KERNEL_PARALLEL_CANCEL:
+        {
+            quadratic_cancel_token token = {0};
+            CancelTokenInit (&token, 0);
+
+            return SolveQuadraticBatchParallelCancellable (batch, &options,
+                                                           &token, NULL);
+        }
+
+        default:
+            return QUADRATIC_BATCH_BAD_ARGS;
+    }
+}
+
+
+static quadratic_batch_status
+SolveDirtyRows (quadratic_equation_batch*      batch,
+                const quadratic_batch_options* options)
+{
+    double*   c_column = malloc (batch->size * sizeof (double));
+    uint64_t* dirty    = calloc (QUADRATIC_BATCH_DIRTY_WORDS (batch->size),
+                                 sizeof (uint64_t));
+
+    if (c_column == NULL || dirty == NULL)
+    {
+        free (c_column);
+        free (dirty);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    memcpy (c_column, batch->c, batch->size * sizeof (double));
+
+    for (size_t i = 1; i < batch->size; i += 2)
+    {
+        batch->c[i] += 1;
+        BatchMarkDirty (dirty, i);
+    }
+
+    quadratic_batch_status status = SolveQuadraticBatch (batch, options);
+
+    memcpy (batch->c, c_column, batch->size * sizeof (double));
+
+    if (status == QUADRATIC_BATCH_SUCCESS)
+        status = SolveQuadraticBatchDirty (batch, options, dirty);
+
+    free (c_column);
+    free (dirty);
+    return status;
+}
+
+
+static quadratic_batch_status
+SolveHandleRows (quadratic_equation_batch* batch)
+{
+    quadratic_equation_handle handle = {0};
+
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        const double a_coef = batch->a[i];
+        const double b_coef = batch->b[i];
+        const double c_coef = batch->c[i];
+        const quadratic_equation_roots* roots = NULL;
+
+        switch (i % 3)
+        {
+            case 0:
+                HandleInit (&handle, 1, b_coef, c_coef);
+                roots = HandleUpdateA (&handle, a_coef);
+                break;
+
+            case 1:
+                HandleInit (&handle, a_coef, 1, c_coef);
+                roots = HandleUpdateB (&handle, b_coef);
+                break;
+
+            default:
+                HandleInit (&handle, a_coef, b_coef, 1);
+                roots = HandleUpdateC (&handle, c_coef);
+                break;
+        }
+
+        batch->x1[i]           = roots->x1;
+        batch->x2[i]           = roots->x2;
+        batch->roots_number[i] = roots->roots_number;
+    }
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+static quadratic_batch_status
+SolveAsyncRows (quadratic_equation_batch* batch)
+{
+    const size_t max_requests = batch->size;
+
+    quadratic_equation_batch* views = calloc (max_requests,
+                                              sizeof (quadratic_equation_batch));
+    quadratic_async_request* requests = calloc (max_requests,
+                                                sizeof (quadratic_async_request));
+
+    quadratic_async_options options = {0};
+    AsyncOptionsInit (&options);
+    options.threads = CHECK_PARALLEL_THREADS;
+
+    quadratic_async_pool* pool = AsyncPoolConstructor (&options);
+
+    if (views == NULL || requests == NULL || pool == NULL)
+    {
+        free (views);
+        free (requests);
+        pool = AsyncPoolDestructor (pool);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    size_t requests_number = 0;
+
+    for (size_t first_row = 0; first_row < batch->size; requests_number++)
+    {
+        size_t rows = 1 + (first_row * 7 + requests_number) %
+                          CHECK_ASYNC_MAX_REQUEST_ROWS;
+        if (rows > batch->size - first_row) rows = batch->size - first_row;
+
+        quadratic_equation_batch* view = &views[requests_number];
+
+        view->size         = rows;
+        view->a            = batch->a  + first_row;
+        view->b            = batch->b  + first_row;
+        view->c            = batch->c  + first_row;
+        view->x1           = batch->x1 + first_row;
+        view->x2           = batch->x2 + first_row;
+        view->roots_number = batch->roots_number + first_row;
+
+        AsyncSubmit (pool, &requests[requests_number], view, NULL, NULL);
+
+        first_row += rows;
+    }
+
+    quadratic_batch_status status = QUADRATIC_BATCH_SUCCESS;
+
+    for (size_t i = 0; i < requests_number; i++)
+    {
+        quadratic_batch_status request_status = AsyncWait (pool, &requests[i]);
+        if (request_status != QUADRATIC_BATCH_SUCCESS) status = request_status;
+    }
+
+    pool = AsyncPoolDestructor (pool);
+    free (views);
+    free (requests);
+
+    return status;
+}
+
+
+static quadratic_batch_status
+SolvePackedRows (quadratic_equation_batch* batch,
+                 bool                      is_float)
+{
+    quadratic_batch_status status = SolveQuadraticBatch (batch, NULL);
+    if (status != QUADRATIC_BATCH_SUCCESS) return status;
+
+    quadratic_packed_roots* packed = PackedRootsConstructor (batch->size, is_float);
+    if (packed == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    status = PackedRootsEncode (packed, batch);
+
+    if (status == QUADRATIC_BATCH_SUCCESS)
+    {
+        for (size_t i = 0; i < batch->size; i++)
+        {
+            batch->x1[i]           = 0;
+            batch->x2[i]           = 0;
+            batch->roots_number[i] = QUADRATIC_EQUATION_NOT_SOLVED;
+        }
+
+        status = PackedRootsDecode (packed, batch);
+    }
+
+    for (size_t i = 1; status == QUADRATIC_BATCH_SUCCESS && i < batch->size;
+         i += 2)
+        batch->roots_number[i] =
+            PackedRootsGet (packed, i, &batch->x1[i], &batch->x2[i]);
+
+    packed = PackedRootsDestructor (packed);
+
+    return status;
+}
+
+
+static quadratic_batch_status
+SolveCancelledRows (quadratic_equation_batch* batch,
+                    check_invariant*          broken)
+{
+    quadratic_cancel_token token = {0};
+    CancelTokenInit   (&token, 0);
+    CancelTokenCancel (&token);
+
+    size_t solved_rows = 0;
+    quadratic_batch_status status =
+        SolveQuadraticBatchCancellable (batch, NULL, &token, &solved_rows);
+
+    if (batch->size != 0 &&
+        (status != QUADRATIC_BATCH_CANCELLED || solved_rows != 0))
+    {
+        broken->message = CHECK_CANCELLED_INVARIANT;
+        broken->row     = 0;
+    }
+
+    CancelTokenInit (&token, 0);
+
+    const size_t first_row = batch->size / 2;
+
+    quadratic_equation_batch rest = {0};
+    BatchSlice (batch, first_row, batch->size - first_row, &rest);
+
+    status = SolveQuadraticBatchCancellable (&rest, NULL, &token, &solved_rows);
+    if (status != QUADRATIC_BATCH_SUCCESS) return status;
+
+    if (solved_rows != rest.size && broken->message == NULL)
+    {
+        broken->message = CHECK_RESUMED_INVARIANT;
+        broken->row     = (solved_rows < rest.size) ? first_row + solved_rows :
+                                                      first_row;
+    }
+
+    quadratic_equation_batch first = {0};
+    BatchSlice (batch, 0, first_row, &first);
+
+    return SolveQuadraticBatchCancellable (&first, NULL, &token, NULL);
+}
+
+
+static quadratic_batch_status
+SolvePlacedRows (quadratic_equation_batch*         batch,
+                 const quadratic_parallel_options* options,
+                 check_invariant*                  broken)
+{
+    if (batch->size == 0) return QUADRATIC_BATCH_SUCCESS;
+
+    quadratic_equation_batch* placed =
+        BatchParallelConstructor (batch->size, options);
+    if (placed == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        if (fabs (placed->a[i]) + fabs (placed->b[i]) + fabs (placed->c[i]) <= 0 &&
+            isnan (placed->x1[i]) && isnan (placed->x2[i]) &&
+            placed->roots_number[i] == QUADRATIC_EQUATION_NOT_SOLVED)
+            continue;
+
+        broken->message = CHECK_PLACED_INVARIANT;
+        broken->row     = i;
+        break;
+    }
+
+    memcpy (placed->a, batch->a, batch->size * sizeof (double));
+    memcpy (placed->b, batch->b, batch->size * sizeof (double));
+    memcpy (placed->c, batch->c, batch->size * sizeof (double));
+
+    const quadratic_batch_status status =
+        SolveQuadraticBatchParallel (placed, options);
+
+    memcpy (batch->x1, placed->x1, batch->size * sizeof (double));
+    memcpy (batch->x2, placed->x2, batch->size * sizeof (double));
+    memcpy (batch->roots_number, placed->roots_number,
+            batch->size * sizeof (quadratic_equation_roots_number));
+
+    placed = BatchDestructor (placed);
+
+    return status;
+}
+
+
+static quadratic_batch_status
+SolveRuntimeRows (quadratic_equation_batch* batch)
+{
+    const size_t max_jobs = batch->size;
+
+    quadratic_equation_batch* views = calloc (max_jobs,
+                                              sizeof (quadratic_equation_batch));
+    quadratic_runtime_job* jobs = calloc (max_jobs,
+                                          sizeof (quadratic_runtime_job));
+
+    quadratic_runtime_options options = {0};
+    RuntimeOptionsInit (&options);
+    options.threads        = CHECK_PARALLEL_THREADS;
+    options.tenants_number = CHECK_RUNTIME_TENANTS_NUMBER;
+    options.slice_rows     = CHECK_RUNTIME_SLICE_ROWS;
+
+    quadratic_runtime* runtime = RuntimeConstructor (&options);
+
+    if (views == NULL || jobs == NULL || runtime == NULL)
+    {
+        free (views);
+        free (jobs);
+        runtime = RuntimeDestructor (runtime);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    size_t jobs_number = 0;
+
+    for (size_t first_row = 0; first_row < batch->size; jobs_number++)
+    {
+        size_t rows = 1 + (first_row * 13 + jobs_number) %
+                          CHECK_RUNTIME_MAX_JOB_ROWS;
+        if (rows > batch->size - first_row) rows = batch->size - first_row;
+
+        BatchSlice (batch, first_row, rows, &views[jobs_number]);
+
+        const quadratic_priority priority = (rows < CHECK_RUNTIME_SLICE_ROWS) ?
+                                            QUADRATIC_PRIORITY_INTERACTIVE :
+                                            QUADRATIC_PRIORITY_BULK;
+
+        RuntimeSubmit (runtime, &jobs[jobs_number], &views[jobs_number],
+                       jobs_number % CHECK_RUNTIME_TENANTS_NUMBER, priority,
+                       NULL, NULL);
+
+        first_row += rows;
+    }
+
+    quadratic_batch_status status = QUADRATIC_BATCH_SUCCESS;
+
+    for (size_t i = 0; i < jobs_number; i++)
+    {
+        quadratic_batch_status job_status = RuntimeWait (runtime, &jobs[i]);
+        if (job_status != QUADRATIC_BATCH_SUCCESS) status = job_status;
+    }
+
+    runtime = RuntimeDestructor (runtime);
+    free (views);
+    free (jobs);
+
+    return status;
+}
+
+
+static quadratic_batch_status
+SolveLocalRows (quadratic_equation_batch* batch)
+{
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        const quadratic_equation_roots* roots =
+            SolveQuadraticEquationLocal (batch->a[i], batch->b[i], batch->c[i]);
+
+        batch->x1[i]           = roots->x1;
+        batch->x2[i]           = roots->x2;
+        batch->roots_number[i] = roots->roots_number;
+    }
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+static quadratic_batch_status
+SolveVerifiedRows (quadratic_equation_batch* batch,
+                   check_invariant*          broken)
+{
+    double*   residuals = calloc (batch->size + 1, sizeof (double));
+    uint64_t* flagged   = calloc (QUADRATIC_BATCH_DIRTY_WORDS (batch->size) + 1,
+                                  sizeof (uint64_t));
+
+    if (residuals == NULL || flagged == NULL)
+    {
+        free (residuals);
+        free (flagged);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    size_t flagged_count = 0;
+    quadratic_batch_status status =
+        SolveQuadraticBatchVerified (batch, NULL, CHECK_VERIFY_THRESHOLD,
+                                     residuals, flagged, &flagged_count);
+
+    size_t count = 0;
+
+    for (size_t i = 0; status == QUADRATIC_BATCH_SUCCESS && i < batch->size; i++)
+    {
+        const bool is_flagged =
+            (flagged[i / QUADRATIC_BATCH_DIRTY_WORD_ROWS] >>
+             (i % QUADRATIC_BATCH_DIRTY_WORD_ROWS)) & 1;
+
+        if (is_flagged == (residuals[i] <= CHECK_VERIFY_THRESHOLD) &&
+            broken->message == NULL)
+        {
+            broken->message = CHECK_FLAGGED_INVARIANT;
+            broken->row     = i;
+        }
+
+        count += is_flagged;
+    }
+
+    if (status == QUADRATIC_BATCH_SUCCESS && count != flagged_count &&
+        broken->message == NULL)
+    {
+        broken->message = CHECK_FLAGGED_COUNT_INVARIANT;
+        broken->row     = 0;
+    }
+
+    free (residuals);
+    free (flagged);
+
+    return status;
+}
+
+
+static quadratic_batch_status
+SolveParsedRows (quadratic_equation_batch* batch,
+                 check_invariant*          broken)
+{
+    quadratic_equation_batch* parsed = BatchConstructor (batch->size);
+    if (parsed == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        if (i % CHECK_NUMBER_ROWS_STEP != 0)
+        {
+            parsed->a[i] = batch->a[i];
+            parsed->b[i] = batch->b[i];
+            parsed->c[i] = batch->c[i];
+
+            continue;
+        }
+
+        const bool is_parsed = ParseCoefTexts (batch->a[i], i, &parsed->a[i]) &
+                               ParseCoefTexts (batch->b[i], i, &parsed->b[i]) &
+                               ParseCoefTexts (batch->c[i], i, &parsed->c[i]);
+
+        if (!is_parsed && broken->message == NULL)
+        {
+            broken->message = CHECK_PARSED_INVARIANT;
+            broken->row     = i;
+        }
+    }
+
+    const quadratic_batch_status status = SolveQuadraticBatch (parsed, NULL);
+
+    if (status == QUADRATIC_BATCH_SUCCESS && batch->size != 0)
+    {
+        memcpy (batch->x1, parsed->x1, batch->size * sizeof (double));
+        memcpy (batch->x2, parsed->x2, batch->size * sizeof (double));
+        memcpy (batch->roots_number, parsed->roots_number,
+                batch->size * sizeof (quadratic_equation_roots_number));
+    }
+
+    parsed = BatchDestructor (parsed);
+
+    return status;
+}
+
+
+static bool
+ParseCoefTexts (double  value,
+                size_t  row,
+                double* parsed)
+{
+    char text   [CHECK_NUMBER_LENGTH] = "";
+    char wrapped[CHECK_NUMBER_LENGTH] = "";
+
+    bool is_parsed = true;
+
+    // The first format is parsed for the solve, the others take turns by rows
+    const size_t formats[] = {0, 1 + row % (CHECK_NUMBER_FORMATS_NUMBER - 1)};
+
+    for (size_t f = 0; f < sizeof (formats) / sizeof (formats[0]); f++)
+    {
+        snprintf (text, sizeof (text), CHECK_NUMBER_FORMATS[formats[f]], value);
+
+        char* text_end = NULL;
+        double expected = strtod (text, &text_end);
+        if (*text_end != '\0') expected = NAN;
+
+        const char* wrapper = (f == 0) ? CHECK_NUMBER_WRAPPERS[0] :
+            CHECK_NUMBER_WRAPPERS[row % CHECK_NUMBER_WRAPPERS_NUMBER];
+        const int length = snprintf (wrapped, sizeof (wrapped), wrapper, text);
+
+        const double actual = CsvParseNumber (wrapped, wrapped + length);
+        if (!IsSameDouble (actual, expected)) is_parsed = false;
+
+        if (f == 0) *parsed = actual;
+    }
+
+    return is_parsed;
+}
+
+
+static bool
+IsSameDouble (double x,
+              double y)
+{
+    if (isnan (x) || isnan (y)) return isnan (x) && isnan (y);
+
+    return memcmp (&x, &y, sizeof (double)) == 0;
+}
+
+
+static quadratic_batch_status
+SolveCsvStreamRows (quadratic_equation_batch* batch,
+                    check_invariant*          broken)
+{
+    csv_ingest_options options = {0};
+    CsvIngestOptionsInit (&options);
+    options.threads = 1;
+
+    FILE* input  = WriteCsvInput (batch, 0);
+    FILE* text   = tmpfile ();
+    FILE* arrow  = tmpfile ();
+
+    size_t text_rows  = 0;
+    size_t arrow_rows = 0;
+    csv_ingest_status status = CSV_INGEST_IO_ERROR;
+
+    if (input != NULL && text != NULL && arrow != NULL)
+    {
+        status = CsvSolveStream (input, text, &options, &text_rows);
+
+        options.arrow_output = true;
+        if (status == CSV_INGEST_SUCCESS)
+        {
+            rewind (input);
+            status = CsvSolveStream (input, arrow, &options, &arrow_rows);
+        }
+    }
+
+    size_t text_size  = 0;
+    size_t arrow_size = 0;
+    char*  text_data  = NULL;
+    char*  arrow_data = NULL;
+
+    if (status == CSV_INGEST_SUCCESS)
+    {
+        text_data  = ReadStream (text,  &text_size);
+        arrow_data = ReadStream (arrow, &arrow_size);
+    }
+
+    if (input != NULL) fclose (input);
+    if (text  != NULL) fclose (text);
+    if (arrow != NULL) fclose (arrow);
+
+    if (status == CSV_INGEST_ALLOC_ERROR)
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    if (status != CSV_INGEST_SUCCESS || text_rows  != batch->size ||
+                                        arrow_rows != batch->size ||
+        text_data == NULL || arrow_data == NULL)
+    {
+        if (broken->message == NULL)
+        {
+            broken->message = CHECK_CSV_STATUS_INVARIANT;
+            broken->row     = (text_rows < batch->size) ? text_rows : 0;
+        }
+
+        free (text_data);
+        free (arrow_data);
+        return QUADRATIC_BATCH_SUCCESS;
+    }
+
+    ParseCsvRoots (text_data, text_size, batch, broken);
+
+    arrow_buffer expected = {0};
+    arrow_output_status arrow_status = ArrowEncodeSchema (&expected);
+    if (arrow_status == ARROW_OUTPUT_SUCCESS && batch->size != 0)
+        arrow_status = ArrowEncodeRecordBatch (&expected, batch);
+    if (arrow_status == ARROW_OUTPUT_SUCCESS)
+        arrow_status = ArrowEncodeEndOfStream (&expected);
+
+    const bool is_same = arrow_status == ARROW_OUTPUT_SUCCESS &&
+                         expected.size == arrow_size &&
+                         memcmp (expected.data, arrow_data, arrow_size) == 0;
+
+    if (arrow_status == ARROW_OUTPUT_SUCCESS && !is_same &&
+        broken->message == NULL)
+    {
+        broken->message = CHECK_CSV_ARROW_INVARIANT;
+        broken->row     = 0;
+    }
+
+    ArrowBufferDestructor (&expected);
+    free (text_data);
+    free (arrow_data);
+
+    return (arrow_status == ARROW_OUTPUT_SUCCESS) ? QUADRATIC_BATCH_SUCCESS :
+                                                    QUADRATIC_BATCH_ALLOC_ERROR;
+}
+
+
+static quadratic_batch_status
+SolveCsvResumedRows (quadratic_equation_batch* batch,
+                     check_invariant*          broken)
+{
+    char checkpoint_path[sizeof (CHECK_RESUME_CHECKPOINT_TEMPLATE)] = "";
+    memcpy (checkpoint_path, CHECK_RESUME_CHECKPOINT_TEMPLATE,
+            sizeof (CHECK_RESUME_CHECKPOINT_TEMPLATE));
+
+    const int checkpoint_file = mkstemp (checkpoint_path);
+    if (checkpoint_file < 0) return QUADRATIC_BATCH_ALLOC_ERROR;
+    close  (checkpoint_file);
+    remove (checkpoint_path);
+
+    const size_t padding = (batch->size != 0) ?
+                           CHECK_RESUME_INPUT_SIZE / batch->size : 0;
+
+    csv_ingest_options options = {0};
+    CsvIngestOptionsInit (&options);
+    options.threads = 1;
+
+    FILE* input       = WriteCsvInput (batch, padding);
+    FILE* expected    = tmpfile ();
+    FILE* resumed     = tmpfile ();
+    FILE* interrupted = NULL;
+
+    check_failing_input failing = {input, 0};
+    const cookie_io_functions_t failing_functions =
+    {
+        .read  = ReadFailingInput,
+        .write = NULL,
+        .seek  = SeekFailingInput,
+        .close = NULL
+    };
+
+    size_t rows = 0;
+    csv_ingest_status status = CSV_INGEST_IO_ERROR;
+
+    if (input != NULL && fseeko (input, 0, SEEK_END) == 0)
+    {
+        failing.limit = ftello (input) / 4 * 3;
+        rewind (input);
+
+        interrupted = fopencookie (&failing, "r", failing_functions);
+    }
+
+    if (interrupted != NULL && expected != NULL && resumed != NULL)
+        status = CsvSolveStream (input, expected, &options, &rows);
+
+    bool is_interrupted = false;
+
+    if (status == CSV_INGEST_SUCCESS)
+    {
+        rewind (input);
+
+        options.checkpoint_path     = checkpoint_path;
+        options.checkpoint_interval = CHECK_RESUME_CHECKPOINT_INTERVAL;
+
+        is_interrupted =
+            CsvSolveStream (interrupted, resumed, &options, NULL) ==
+            CSV_INGEST_IO_ERROR && access (checkpoint_path, F_OK) == 0;
+
+        rewind (input);
+
+        options.resume = true;
+        status = CsvSolveStream (input, resumed, &options, &rows);
+    }
+
+    size_t expected_size = 0;
+    size_t resumed_size  = 0;
+    char*  expected_data = NULL;
+    char*  resumed_data  = NULL;
+
+    if (status == CSV_INGEST_SUCCESS)
+    {
+        expected_data = ReadStream (expected, &expected_size);
+        resumed_data  = ReadStream (resumed,  &resumed_size);
+    }
+
+    if (interrupted != NULL) fclose (interrupted);
+    if (input       != NULL) fclose (input);
+    if (expected    != NULL) fclose (expected);
+    if (resumed     != NULL) fclose (resumed);
+
+    remove (checkpoint_path);
+
+    if (status == CSV_INGEST_ALLOC_ERROR)
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    if (status != CSV_INGEST_SUCCESS || rows != batch->size ||
+        expected_data == NULL || resumed_data == NULL)
+    {
+        if (broken->message == NULL)
+        {
+            broken->message = CHECK_CSV_STATUS_INVARIANT;
+            broken->row     = (rows < batch->size) ? rows : 0;
+        }
+
+        free (expected_data);
+        free (resumed_data);
+        return QUADRATIC_BATCH_SUCCESS;
+    }
+
+    ParseCsvRoots (expected_data, expected_size, batch, broken);
+
+    if (!is_interrupted && broken->message == NULL)
+    {
+        broken->message = CHECK_CSV_CHECKPOINT_INVARIANT;
+        broken->row     = 0;
+    }
+
+    const size_t common_size = (expected_size < resumed_size) ? expected_size :
+                                                                resumed_size;
+
+    size_t differ = 0;
+    while (differ < common_size && expected_data[differ] == resumed_data[differ])
+        differ++;
+
+    if ((differ < common_size || expected_size != resumed_size) &&
+        broken->message == NULL)
+    {
+        // The header line is not a row
+        size_t line = 0;
+        for (size_t i = 0; i < differ; i++)
+            if (expected_data[i] == '\n') line++;
+
+        broken->message = CHECK_CSV_RESUME_INVARIANT;
+        broken->row     = (line > 0) ? line - 1 : 0;
+    }
+
+    free (expected_data);
+    free (resumed_data);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+static ssize_t
+ReadFailingInput (void*  input_ptr,
+                  char*  buffer,
+                  size_t size)
+{
+    check_failing_input* input = input_ptr;
+
+    const off_t offset = ftello (input->file);
+    if (offset < 0 || offset >= input->limit)
+    {
+        errno = EIO;
+        return -1;
+    }
+
+    if ((off_t) size > input->limit - offset)
+        size = (size_t) (input->limit - offset);
+
+    const size_t read_size = fread (buffer, 1, size, input->file);
+    if (read_size == 0 && ferror (input->file)) return -1;
+
+    return (ssize_t) read_size;
+}
+
+
+static int
+SeekFailingInput (void*    input_ptr,
+                  off64_t* offset,
+                  int      whence)
+{
+    check_failing_input* input = input_ptr;
+
+    if (fseeko (input->file, (off_t) *offset, whence) != 0) return -1;
+
+    const off_t position = ftello (input->file);
+    if (position < 0) return -1;
+
+    *offset = position;
+    return 0;
+}
+
+
+static FILE*
+WriteCsvInput (const quadratic_equation_batch* batch,
+               size_t                          padding)
+{
+    // Padding field with the delimiter before it and the line end
+    char* line_end = malloc (padding + 2);
+    FILE* input    = (line_end != NULL) ? tmpfile () : NULL;
+    if (input == NULL)
+    {
+        free (line_end);
+        return NULL;
+    }
+
+    const size_t line_end_size = (padding > 0) ? padding + 2 : 1;
+    memset (line_end, ' ', padding + 2);
+    line_end[0]                 = ',';
+    line_end[line_end_size - 1] = '\n';
+
+    bool is_written = fputs ((padding > 0) ? "a,b,c,padding\n" : "a,b,c\n",
+                             input) != EOF;
+
+    for (size_t i = 0; is_written && i < batch->size; i++)
+        is_written = fprintf (input, "%.17g,%.17g,%.17g",
+                              batch->a[i], batch->b[i], batch->c[i]) > 0 &&
+                     fwrite (line_end, 1, line_end_size, input) == line_end_size;
+
+    free (line_end);
+
+    if (!is_written || fflush (input) != 0)
+    {
+        fclose (input);
+        return NULL;
+    }
+
+    rewind (input);
+    return input;
+}
+
+
+static char*
+ReadStream (FILE*   stream,
+            size_t* size)
+{
+    if (fseek (stream, 0, SEEK_END) != 0) return NULL;
+
+    const long length = ftell (stream);
+    if (length < 0) return NULL;
+
+    rewind (stream);
+
+    char* data = malloc ((size_t) length + 1);
+    if (data == NULL) return NULL;
+
+    if (fread (data, 1, (size_t) length, stream) != (size_t) length)
+    {
+        free (data);
+        return NULL;
+    }
+
+    data[length] = '\0';
+    *size = (size_t) length;
+
+    return data;
+}
+
+
+static void
+ParseCsvRoots (const char*               text,
+               size_t                    size,
+               quadratic_equation_batch* batch,
+               check_invariant*          broken)
+{
+    const char* end  = text + size;
+    const char* line = memchr (text, '\n', size);
+    line = (line != NULL) ? line + 1 : end;
+
+    for (size_t i = 0; i < batch->size; i++)
+    {
+        const char* line_end = (line < end) ?
+            memchr (line, '\n', (size_t) (end - line)) : NULL;
+
+        bool is_valid = line_end != NULL && line_end - line >= 3 &&
+                        line[0] >= '0' && line[0] <= '9' && line[1] == ',';
+
+        batch->x1[i] = NAN;
+        batch->x2[i] = NAN;
+        batch->roots_number[i] = QUADRATIC_EQUATION_NOT_SOLVED;
+
+        if (is_valid)
+        {
+            batch->roots_number[i] = (quadratic_equation_roots_number)
+                                     (line[0] - '0');
+
+            const char* field = line + 2;
+            char*       field_end = (char*) field;
+
+            if (*field != ',') batch->x1[i] = strtod (field, &field_end);
+            is_valid = (*field_end == ',');
+
+            field = field_end + 1;
+            field_end = (char*) field;
+
+            if (is_valid && *field != '\n')
+                batch->x2[i] = strtod (field, &field_end);
+            is_valid = is_valid && (field_end == line_end);
+        }
+
+        if (!is_valid)
+        {
+            if (broken->message == NULL)
+            {
+                broken->message = CHECK_CSV_TEXT_INVARIANT;
+                broken->row     = i;
+            }
+
+            return;
+        }
+
+        line = line_end + 1;
+    }
+}
+
+
+static quadratic_batch_status
+SolveRuntimeOrderRows (quadratic_equation_batch* batch,
+                       check_invariant*          broken)
+{
+    quadratic_runtime_options options = {0};
+    RuntimeOptionsInit (&options);
+    options.threads           = 1;
+    options.tenants_number    = CHECK_RUNTIME_TENANTS_NUMBER;
+    options.slice_rows        = batch->size + 1;
+    options.interactive_burst = CHECK_RUNTIME_ORDER_BURST;
+
+    quadratic_runtime* runtime = RuntimeConstructor (&options);
+    if (runtime == NULL) return QUADRATIC_BATCH_ALLOC_ERROR;
+
+    quadratic_runtime_job    jobs [CHECK_RUNTIME_ORDER_JOBS_NUMBER + 1] = {0};
+    quadratic_equation_batch views[CHECK_RUNTIME_ORDER_JOBS_NUMBER + 1] = {0};
+
+    check_runtime_order order = {.jobs = jobs};
+    pthread_mutex_init (&order.lock,    NULL);
+    pthread_cond_init  (&order.changed, NULL);
+
+    // Every job is one slice, the gate is the last job and takes the first rows
+    const size_t gate = CHECK_RUNTIME_ORDER_JOBS_NUMBER;
+    const size_t rows = batch->size / (CHECK_RUNTIME_ORDER_JOBS_NUMBER + 1);
+
+    size_t expected_rows[QUADRATIC_PRIORITY_COUNT] = {rows, 0};
+    size_t expected_jobs[QUADRATIC_PRIORITY_COUNT] = {1,    0};
+
+    BatchSlice (batch, 0, rows, &views[gate]);
+    quadratic_batch_status status =
+        RuntimeSubmit (runtime, &jobs[gate], &views[gate], 0,
+                       QUADRATIC_PRIORITY_INTERACTIVE, HoldRuntimeGate, &order);
+
+    pthread_mutex_lock (&order.lock);
+    while (status == QUADRATIC_BATCH_SUCCESS && !order.is_entered)
+        pthread_cond_wait (&order.changed, &order.lock);
+    pthread_mutex_unlock (&order.lock);
+
+    for (size_t i = 0; status == QUADRATIC_BATCH_SUCCESS &&
+                       i < CHECK_RUNTIME_ORDER_JOBS_NUMBER; i++)
+    {
+        const size_t first_row = (i + 1) * rows;
+        const size_t job_rows  = (i + 1 == CHECK_RUNTIME_ORDER_JOBS_NUMBER) ?
+                                 batch->size - first_row : rows;
+
+        const quadratic_priority priority = CHECK_RUNTIME_ORDER_JOBS[i].priority;
+        expected_rows[priority] += job_rows;
+        expected_jobs[priority]++;
+
+        BatchSlice (batch, first_row, job_rows, &views[i]);
+        status = RuntimeSubmit (runtime, &jobs[i], &views[i],
+                                CHECK_RUNTIME_ORDER_JOBS[i].tenant, priority,
+                                LogRuntimeCompletion, &order);
+    }
+
+    pthread_mutex_lock (&order.lock);
+    order.is_open = true;
+    pthread_cond_broadcast (&order.changed);
+    pthread_mutex_unlock (&order.lock);
+
+    quadratic_runtime_metrics metrics = {0};
+    if (status == QUADRATIC_BATCH_SUCCESS)
+    {
+        for (size_t i = 0; i <= CHECK_RUNTIME_ORDER_JOBS_NUMBER; i++)
+        {
+            quadratic_batch_status job_status = RuntimeWait (runtime, &jobs[i]);
+            if (job_status != QUADRATIC_BATCH_SUCCESS) status = job_status;
+        }
+
+        RuntimeGetMetrics (runtime, &metrics);
+    }
+
+    // Joins the worker, so every callback has returned
+    runtime = RuntimeDestructor (runtime);
+
+    pthread_mutex_destroy (&order.lock);
+    pthread_cond_destroy  (&order.changed);
+
+    if (status != QUADRATIC_BATCH_SUCCESS) return status;
+
+    for (size_t i = 0; i < CHECK_RUNTIME_ORDER_JOBS_NUMBER; i++)
+    {
+        const size_t expected = CHECK_RUNTIME_ORDER_EXPECTED[i];
+        if (i < order.completed_number && order.completed[i] == expected)
+            continue;
+
+        broken->message = CHECK_RUNTIME_ORDER_INVARIANT;
+        broken->row     = (expected + 1) * rows;
+        return status;
+    }
+
+    for (size_t priority = 0; priority < QUADRATIC_PRIORITY_COUNT; priority++)
+    {
+        const quadratic_runtime_class_metrics* class_metrics =
+            &metrics.classes[priority];
+
+        if (class_metrics->submitted_jobs != expected_jobs[priority] ||
+            class_metrics->completed_jobs != expected_jobs[priority] ||
+            class_metrics->solved_rows    != expected_rows[priority] ||
+            class_metrics->queued_jobs    != 0 ||
+            class_metrics->queued_rows    != 0)
+        {
+            broken->message = CHECK_RUNTIME_METRICS_INVARIANT;
+            broken->row     = 0;
+            return status;
+        }
+    }
+
+    return status;
+}
+
+
+static void
+HoldRuntimeGate (quadratic_runtime_job* job,
+                 void*                  order_ptr)
+{
+    (void) job;
+    check_runtime_order* order = order_ptr;
+
+    pthread_mutex_lock (&order->lock);
+
+    order->is_entered = true;
+    pthread_cond_broadcast (&order->changed);
+
+    while (!order->is_open)
+        pthread_cond_wait (&order->changed, &order->lock);
+
+    pthread_mutex_unlock (&order->lock);
+}
+
+
+static void
+LogRuntimeCompletion (quadratic_runtime_job* job,
+                      void*                  order_ptr)
+{
+    check_runtime_order* order = order_ptr;
+
+    // The single worker runs the callbacks one by one
+    if (order->completed_number < CHECK_RUNTIME_ORDER_JOBS_NUMBER)
+        order->completed[order->completed_number++] =
+            (size_t) (job - order->jobs);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// libFuzzer entry point
+//------------------------------------------------------------------------------
+
+#ifdef QUADRATIC_EQUATION_FUZZER
+
+int
+LLVMFuzzerTestOneInput (const uint8_t* data,
+                        size_t         size);
+
+int
+LLVMFuzzerTestOneInput (const uint8_t* data,
+                        size_t         size)
+{
+    quadratic_check_report report = {0};
+
+    if (CheckRawInput (data, size, &report) == QUADRATIC_BATCH_SUCCESS &&
+        report.diverged)
+        abort ();
+
+    return 0;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,151 @@
+/**
+ * @file quadratic_equation_handle.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Incremental re-solve implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "quadratic_equation_handle.h"
+#include "quadratic_equation_row.h"
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Finds the roots from the cached values
+ *
+ * @param handle Pointer to the handle with up to date cached values
+ *
+ * @retval Pointer to the roots of the handle
+ *
+ * @details Follows CalculateRoots() rules by SolveQuadraticRowByDiscriminant(),
+ * NaN discriminant gives QUADRATIC_EQUATION_NOT_SOLVED
+ */
+static const quadratic_equation_roots*
+FindHandleRoots (quadratic_equation_handle* handle);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Handle interface implementation
+//------------------------------------------------------------------------------
+
+quadratic_equation_handle*
+HandleConstructor (double a_coef,
+                   double b_coef,
+                   double c_coef)
+{
+    quadratic_equation_handle* handle =
+        malloc (sizeof (quadratic_equation_handle));
+    if (handle == NULL) return NULL;
+
+    HandleInit (handle, a_coef, b_coef, c_coef);
+
+    return handle;
+}
+
+
+quadratic_equation_handle*
+HandleDestructor (quadratic_equation_handle* handle)
+{
+    free (handle);
+    return NULL;
+}
+
+
+const quadratic_equation_roots*
+HandleInit (quadratic_equation_handle* handle,
+            double                     a_coef,
+            double                     b_coef,
+            double                     c_coef)
+{
+    if (handle == NULL) return NULL;
+
+    handle->coefs.a  = a_coef;
+    handle->coefs.b  = b_coef;
+    handle->coefs.c  = c_coef;
+    handle->b_square = b_coef * b_coef;
+
+    return HandleUpdateA (handle, a_coef);
+}
+
+
+const quadratic_equation_roots*
+HandleUpdateA (quadratic_equation_handle* handle,
+               double                     a_coef)
+{
+    if (handle == NULL) return NULL;
+
+    handle->coefs.a      = a_coef;
+    handle->a_quadruple  = 4 * a_coef;
+    handle->ac_quadruple = handle->a_quadruple * handle->coefs.c;
+
+    return FindHandleRoots (handle);
+}
+
+
+const quadratic_equation_roots*
+HandleUpdateB (quadratic_equation_handle* handle,
+               double                     b_coef)
+{
+    if (handle == NULL) return NULL;
+
+    handle->coefs.b  = b_coef;
+    handle->b_square = b_coef * b_coef;
+
+    return FindHandleRoots (handle);
+}
+
+
+const quadratic_equation_roots*
+HandleUpdateC (quadratic_equation_handle* handle,
+               double                     c_coef)
+{
+    if (handle == NULL) return NULL;
+
+    handle->coefs.c      = c_coef;
+    handle->ac_quadruple = handle->a_quadruple * c_coef;
+
+    return FindHandleRoots (handle);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static const quadratic_equation_roots*
+FindHandleRoots (quadratic_equation_handle* handle)
+{
+    quadratic_equation_roots* roots = &handle->roots;
+    const quadratic_equation_coefs* coefs = &handle->coefs;
+
+    handle->discriminant = handle->b_square - handle->ac_quadruple;
+
+    roots->roots_number =
+        SolveQuadraticRowByDiscriminant (coefs->a, coefs->b, coefs->c,
+                                         handle->discriminant,
+                                         &roots->x1, &roots->x2);
+
+    return roots;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,50 @@
+/**
+ * @file quadratic_equation_local.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Low latency solver of single equations implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "quadratic_equation_local.h"
+#include "quadratic_equation_row.h"
+
+
+
+//------------------------------------------------------------------------------
+// Static variables
+//------------------------------------------------------------------------------
+
+/// @brief Roots context of the thread, preallocated with the thread
+static _Thread_local quadratic_equation_roots LOCAL_ROOTS;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Local solver interface implementation
+//------------------------------------------------------------------------------
+
+const quadratic_equation_roots*
+SolveQuadraticEquationLocal (double a_coef,
+                             double b_coef,
+                             double c_coef)
+{
+    quadratic_equation_roots* roots = &LOCAL_ROOTS;
+
+    roots->roots_number = SolveQuadraticRow (a_coef, b_coef, c_coef,
+                                             &roots->x1, &roots->x2);
+
+    return roots;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
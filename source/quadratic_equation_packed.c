@@ -0,0 +1,283 @@
+/**
+ * @file quadratic_equation_packed.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Packed encoding of the batch roots implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "quadratic_equation_packed.h"
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Roots after the stream end written and read by the branch-free loops
+static const size_t PACKED_ROOTS_SLACK = 2;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Finds the number of stored roots of the row
+ *
+ * @param roots_number Number of roots of the row
+ *
+ * @retval 1 for one root, 2 for two roots, 0 otherwise
+ */
+static inline size_t
+StoredRootsNumber (uint8_t roots_number);
+
+
+/**
+ * @brief Rounds the root to float
+ *
+ * @param root Root to round
+ *
+ * @retval The nearest float
+ * @retval Infinity of the root sign if the root is above FLT_MAX in magnitude
+ *
+ * @details The conversion of an out of range double is undefined,
+ * so such roots are saturated explicitly
+ */
+static inline float
+RootToFloat (double root);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Packed roots interface implementation
+//------------------------------------------------------------------------------
+
+quadratic_packed_roots*
+PackedRootsConstructor (size_t capacity,
+                        bool   is_float)
+{
+    quadratic_packed_roots* packed = calloc (1, sizeof (quadratic_packed_roots));
+    if (packed == NULL) return NULL;
+
+    const size_t root_size = is_float ? sizeof (float) : sizeof (double);
+
+    packed->roots_number  = calloc (capacity, sizeof (uint8_t));
+    packed->block_offsets = calloc (QUADRATIC_PACKED_BLOCKS (capacity),
+                                    sizeof (size_t));
+    packed->roots         = calloc (2 * capacity + PACKED_ROOTS_SLACK, root_size);
+
+    if (packed->roots == NULL ||
+        ((packed->roots_number == NULL || packed->block_offsets == NULL) &&
+         capacity != 0))
+        return PackedRootsDestructor (packed);
+
+    packed->capacity = capacity;
+    packed->is_float = is_float;
+
+    return packed;
+}
+
+
+quadratic_packed_roots*
+PackedRootsDestructor (quadratic_packed_roots* packed)
+{
+    if (packed == NULL) return NULL;
+
+    free (packed->roots_number);
+    free (packed->block_offsets);
+    free (packed->roots);
+
+    free (packed);
+    return NULL;
+}
+
+
+quadratic_batch_status
+PackedRootsEncode (quadratic_packed_roots*         packed,
+                   const quadratic_equation_batch* batch)
+{
+    if (packed == NULL || batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (batch->size > packed->capacity) return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (batch->size != 0 &&
+        (batch->x1 == NULL || batch->x2 == NULL || batch->roots_number == NULL))
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    double* double_roots = packed->roots;
+    float*  float_roots  = packed->roots;
+    size_t  offset       = 0;
+
+    for (size_t begin = 0; begin < batch->size;
+         begin += QUADRATIC_PACKED_BLOCK_ROWS)
+    {
+        size_t end = begin + QUADRATIC_PACKED_BLOCK_ROWS;
+        if (end > batch->size) end = batch->size;
+
+        packed->block_offsets[begin / QUADRATIC_PACKED_BLOCK_ROWS] = offset;
+
+        if (packed->is_float)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const uint8_t roots_number = (uint8_t) batch->roots_number[i];
+
+                packed->roots_number[i] = roots_number;
+                float_roots[offset]     = RootToFloat (batch->x1[i]);
+                float_roots[offset + 1] = RootToFloat (batch->x2[i]);
+                offset += StoredRootsNumber (roots_number);
+            }
+        }
+
+        else
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const uint8_t roots_number = (uint8_t) batch->roots_number[i];
+
+                packed->roots_number[i]  = roots_number;
+                double_roots[offset]     = batch->x1[i];
+                double_roots[offset + 1] = batch->x2[i];
+                offset += StoredRootsNumber (roots_number);
+            }
+        }
+    }
+
+    packed->size       = batch->size;
+    packed->roots_size = offset;
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_batch_status
+PackedRootsDecode (const quadratic_packed_roots* packed,
+                   quadratic_equation_batch*     batch)
+{
+    if (packed == NULL || batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (batch->size != packed->size) return QUADRATIC_BATCH_BAD_ARGS;
+
+    if (batch->size != 0 &&
+        (batch->x1 == NULL || batch->x2 == NULL || batch->roots_number == NULL))
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    const double* double_roots = packed->roots;
+    const float*  float_roots  = packed->roots;
+    size_t        offset       = 0;
+
+    if (packed->is_float)
+    {
+        for (size_t i = 0; i < batch->size; i++)
+        {
+            const uint8_t roots_number = packed->roots_number[i];
+            const size_t  stored       = StoredRootsNumber (roots_number);
+
+            batch->roots_number[i] = (quadratic_equation_roots_number) roots_number;
+            batch->x1[i] = (stored >= 1) ? (double) float_roots[offset]     : NAN;
+            batch->x2[i] = (stored >= 2) ? (double) float_roots[offset + 1] : NAN;
+            offset += stored;
+        }
+    }
+
+    else
+    {
+        for (size_t i = 0; i < batch->size; i++)
+        {
+            const uint8_t roots_number = packed->roots_number[i];
+            const size_t  stored       = StoredRootsNumber (roots_number);
+
+            batch->roots_number[i] = (quadratic_equation_roots_number) roots_number;
+            batch->x1[i] = (stored >= 1) ? double_roots[offset]     : NAN;
+            batch->x2[i] = (stored >= 2) ? double_roots[offset + 1] : NAN;
+            offset += stored;
+        }
+    }
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_equation_roots_number
+PackedRootsGet (const quadratic_packed_roots* packed,
+                size_t                        row,
+                double*                       x1,
+                double*                       x2)
+{
+    if (packed == NULL || x1 == NULL || x2 == NULL || row >= packed->size)
+        return QUADRATIC_EQUATION_NOT_SOLVED;
+
+    const size_t block_begin = row - row % QUADRATIC_PACKED_BLOCK_ROWS;
+    size_t offset = packed->block_offsets[row / QUADRATIC_PACKED_BLOCK_ROWS];
+
+    for (size_t i = block_begin; i < row; i++)
+        offset += StoredRootsNumber (packed->roots_number[i]);
+
+    const uint8_t roots_number = packed->roots_number[row];
+    const size_t  stored       = StoredRootsNumber (roots_number);
+
+    double roots[2] = {NAN, NAN};
+    for (size_t i = 0; i < stored; i++)
+        roots[i] = packed->is_float ?
+                   (double) ((const float*)  packed->roots)[offset + i] :
+                            ((const double*) packed->roots)[offset + i];
+
+    *x1 = roots[0];
+    *x2 = roots[1];
+
+    return (quadratic_equation_roots_number) roots_number;
+}
+
+
+size_t
+PackedRootsBytes (const quadratic_packed_roots* packed)
+{
+    if (packed == NULL) return 0;
+
+    const size_t root_size = packed->is_float ? sizeof (float) : sizeof (double);
+
+    return packed->size * sizeof (uint8_t) +
+           QUADRATIC_PACKED_BLOCKS (packed->size) * sizeof (size_t) +
+           packed->roots_size * root_size;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static inline size_t
+StoredRootsNumber (uint8_t roots_number)
+{
+    return (size_t) (roots_number == QUADRATIC_EQUATION_ONE_ROOT) +
+           (size_t) (roots_number == QUADRATIC_EQUATION_TWO_ROOTS) * 2;
+}
+
+
+static inline float
+RootToFloat (double root)
+{
+    return (fabs (root) > FLT_MAX) ? (float) copysign (INFINITY, root) :
+                                     (float) root;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
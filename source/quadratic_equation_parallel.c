@@ -0,0 +1,629 @@
+/**
+ * @file quadratic_equation_parallel.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Multithreaded and NUMA-aware batch solver implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#define _GNU_SOURCE
+
+
+
+#include "quadratic_equation_parallel.h"
+
+
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Rows per page of the narrowest column
+static const size_t PARALLEL_PAGE_ROWS = 4096 / sizeof (quadratic_equation_roots_number);
+
+/// @brief Rows per huge page of the narrowest column
+static const size_t PARALLEL_HUGE_PAGE_ROWS =
+    (1 << 21) / sizeof (quadratic_equation_roots_number);
+
+/// @brief Huge page size
+static const size_t PARALLEL_HUGE_PAGE_SIZE = 1 << 21;
+
+/// @brief Page size
+static const size_t PARALLEL_PAGE_SIZE = 4096;
+
+/// @brief Path to the list of online NUMA nodes
+static const char* const PARALLEL_NODE_ONLINE_PATH =
+    "/sys/devices/system/node/online";
+
+/// @brief Path to the CPU list of the NUMA node
+static const char* const PARALLEL_NODE_CPULIST_FORMAT =
+    "/sys/devices/system/node/node%zu/cpulist";
+
+/// @brief Maximal length of the CPU list
+enum { PARALLEL_CPULIST_LENGTH = 4096 };
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief NUMA topology of the host
+ */
+typedef
+struct numa_topology
+{
+    size_t     nodes_number;    ///< Number of nodes
+    cpu_set_t* node_cpus;       ///< CPUs of every node
+}
+numa_topology;
+
+
+/**
+ * @brief Chunk of the batch processed by one worker
+ */
+typedef
+struct parallel_task
+{
+    quadratic_equation_batch*         batch;        ///< Whole batch
+    size_t                            first_row;    ///< First row of the chunk
+    size_t                            rows;         ///< Rows in the chunk
+    const cpu_set_t*                  cpus;         ///< CPUs to pin to, NULL if any
+    const quadratic_parallel_options* options;      ///< Solver options
+    bool                              initialize;   ///< Touch instead of solve
+    quadratic_cancel_token*           token;        ///< Token, NULL to solve the chunk
+    atomic_size_t*                    next_row;     ///< Next row to claim with the token
+    atomic_size_t*                    solved_rows;  ///< Rows solved with the token
+    quadratic_batch_status            status;       ///< Result of the chunk
+}
+parallel_task;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static variables
+//------------------------------------------------------------------------------
+
+/// @brief Topology of the host, loaded once
+static numa_topology TOPOLOGY = {0};
+
+/// @brief Guard of the topology loading
+static pthread_once_t TOPOLOGY_ONCE = PTHREAD_ONCE_INIT;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Reads NUMA nodes and their CPUs from sysfs
+ *
+ * @details Online nodes are read from PARALLEL_NODE_ONLINE_PATH,
+ * so node numbers may have gaps; nodes without CPUs are skipped
+ * Without sysfs topology the host is one node with
+ * the CPUs the process may run on
+ */
+static void
+LoadTopology (void);
+
+
+/**
+ * @brief Reads the first line of the sysfs file
+ *
+ * @param path Path to the file
+ * @param line Buffer for the line
+ * @param size Size of the buffer
+ *
+ * @retval true if the line is read
+ */
+static bool
+ReadSysfsLine (const char* path,
+               char*       line,
+               size_t      size);
+
+
+/**
+ * @brief Parses CPU or node list like "0-3,8-11"
+ *
+ * @param list CPU or node list
+ * @param cpus Pointer to the set to fill, node numbers are stored as CPUs
+ *
+ * @retval Number of parsed CPUs or nodes
+ */
+static size_t
+ParseCpuList (const char* list,
+              cpu_set_t*  cpus);
+
+
+/**
+ * @brief Runs the chunks of the batch on the worker threads
+ *
+ * @param batch       Pointer to the batch
+ * @param options     Pointer to the options
+ * @param initialize  Touch the chunks instead of solving them
+ * @param token       Cancellation token, NULL to give every worker one chunk
+ * @param solved_rows Pointer to the number of solved rows, may be NULL
+ *
+ * @retval Status @see quadratic_batch_status
+ *
+ * @details With the token workers claim chunks of
+ * QUADRATIC_BATCH_CANCEL_CHUNK_ROWS rows in order and check the token
+ * before every claim, a claimed chunk is always solved,
+ * so the solved rows are the first ones
+ */
+static quadratic_batch_status
+RunTasks (quadratic_equation_batch*         batch,
+          const quadratic_parallel_options* options,
+          bool                              initialize,
+          quadratic_cancel_token*           token,
+          size_t*                           solved_rows);
+
+
+/**
+ * @brief Worker thread routine
+ *
+ * @param task_ptr Pointer to parallel_task
+ *
+ * @retval NULL
+ */
+static void*
+RunTask (void* task_ptr);
+
+
+/**
+ * @brief Claims and solves the chunks until the rows end or the token is cancelled
+ *
+ * @param task Pointer to the task with the token
+ */
+static void
+RunClaimedChunks (parallel_task* task);
+
+
+/**
+ * @brief Rounds the size up to the alignment
+ */
+static inline size_t
+AlignUp (size_t size,
+         size_t alignment);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Parallel solver interface implementation
+//------------------------------------------------------------------------------
+
+void
+ParallelOptionsInit (quadratic_parallel_options* options)
+{
+    if (options == NULL) return;
+
+    options->threads    = 0;
+    options->numa_aware = false;
+    options->huge_pages = false;
+
+    BatchOptionsInit (&options->solve);
+}
+
+
+quadratic_equation_batch*
+BatchParallelConstructor (size_t                            size,
+                          const quadratic_parallel_options* options)
+{
+    quadratic_parallel_options default_options = {0};
+    if (options == NULL)
+    {
+        ParallelOptionsInit (&default_options);
+        options = &default_options;
+    }
+
+    if (size == 0) return BatchConstructor (0);
+
+    const size_t alignment = options->huge_pages ? PARALLEL_HUGE_PAGE_SIZE :
+                                                   PARALLEL_PAGE_SIZE;
+    const size_t column_size = AlignUp (size * sizeof (double), alignment);
+    const size_t roots_number_size =
+        AlignUp (size * sizeof (quadratic_equation_roots_number), alignment);
+
+    const size_t mapping_size = 5 * column_size + roots_number_size;
+
+    quadratic_equation_batch* batch =
+        calloc (1, sizeof (quadratic_equation_batch));
+    if (batch == NULL) return NULL;
+
+    void* mapping = mmap (NULL, mapping_size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+        free (batch);
+        return NULL;
+    }
+
+    if (options->huge_pages) madvise (mapping, mapping_size, MADV_HUGEPAGE);
+
+    char* columns = mapping;
+
+    batch->size         = size;
+    batch->mapping      = mapping;
+    batch->mapping_size = mapping_size;
+    batch->a            = (double*) (columns);
+    batch->b            = (double*) (columns +     column_size);
+    batch->c            = (double*) (columns + 2 * column_size);
+    batch->x1           = (double*) (columns + 3 * column_size);
+    batch->x2           = (double*) (columns + 4 * column_size);
+    batch->roots_number =
+        (quadratic_equation_roots_number*) (columns + 5 * column_size);
+
+    if (RunTasks (batch, options, true, NULL, NULL) != QUADRATIC_BATCH_SUCCESS)
+        return BatchDestructor (batch);
+
+    return batch;
+}
+
+
+quadratic_batch_status
+SolveQuadraticBatchParallel (quadratic_equation_batch*         batch,
+                             const quadratic_parallel_options* options)
+{
+    if (batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+    if (batch->size == 0) return QUADRATIC_BATCH_SUCCESS;
+
+    quadratic_parallel_options default_options = {0};
+    if (options == NULL)
+    {
+        ParallelOptionsInit (&default_options);
+        options = &default_options;
+    }
+
+    return RunTasks (batch, options, false, NULL, NULL);
+}
+
+
+quadratic_batch_status
+SolveQuadraticBatchParallelCancellable (quadratic_equation_batch*         batch,
+                                        const quadratic_parallel_options* options,
+                                        quadratic_cancel_token*           token,
+                                        size_t*                           solved_rows)
+{
+    if (solved_rows != NULL) *solved_rows = 0;
+    if (batch == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+    if (batch->size == 0) return QUADRATIC_BATCH_SUCCESS;
+
+    quadratic_parallel_options default_options = {0};
+    if (options == NULL)
+    {
+        ParallelOptionsInit (&default_options);
+        options = &default_options;
+    }
+
+    if (token == NULL)
+    {
+        const quadratic_batch_status status =
+            RunTasks (batch, options, false, NULL, NULL);
+        if (status == QUADRATIC_BATCH_SUCCESS && solved_rows != NULL)
+            *solved_rows = batch->size;
+
+        return status;
+    }
+
+    return RunTasks (batch, options, false, token, solved_rows);
+}
+
+
+size_t
+ParallelNumaNodesNumber (void)
+{
+    pthread_once (&TOPOLOGY_ONCE, LoadTopology);
+
+    return TOPOLOGY.nodes_number;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static void
+LoadTopology (void)
+{
+    char path[sizeof ("/sys/devices/system/node/node/cpulist") + 24] = "";
+    char list[PARALLEL_CPULIST_LENGTH] = "";
+
+    cpu_set_t online_nodes = {0};
+    CPU_ZERO (&online_nodes);
+
+    if (ReadSysfsLine (PARALLEL_NODE_ONLINE_PATH, list, sizeof (list)) &&
+        ParseCpuList (list, &online_nodes) != 0)
+        TOPOLOGY.node_cpus = calloc ((size_t) CPU_COUNT (&online_nodes),
+                                     sizeof (cpu_set_t));
+
+    for (size_t node = 0; TOPOLOGY.node_cpus != NULL && node < CPU_SETSIZE;
+         node++)
+    {
+        if (!CPU_ISSET (node, &online_nodes)) continue;
+
+        snprintf (path, sizeof (path), PARALLEL_NODE_CPULIST_FORMAT, node);
+        if (!ReadSysfsLine (path, list, sizeof (list))) continue;
+
+        if (ParseCpuList (list, &TOPOLOGY.node_cpus[TOPOLOGY.nodes_number]) != 0)
+            TOPOLOGY.nodes_number++;
+    }
+
+    if (TOPOLOGY.nodes_number != 0) return;
+
+    cpu_set_t* node_cpus = realloc (TOPOLOGY.node_cpus, sizeof (cpu_set_t));
+    if (node_cpus == NULL) return;
+
+    TOPOLOGY.node_cpus    = node_cpus;
+    TOPOLOGY.nodes_number = 1;
+
+    if (sched_getaffinity (0, sizeof (cpu_set_t), node_cpus) != 0)
+    {
+        CPU_ZERO (node_cpus);
+        for (long cpu = 0; cpu < sysconf (_SC_NPROCESSORS_ONLN); cpu++)
+            CPU_SET ((size_t) cpu, node_cpus);
+    }
+}
+
+
+static bool
+ReadSysfsLine (const char* path,
+               char*       line,
+               size_t      size)
+{
+    FILE* file = fopen (path, "r");
+    if (file == NULL) return false;
+
+    const bool is_read = (fgets (line, (int) size, file) != NULL);
+    fclose (file);
+
+    return is_read;
+}
+
+
+static size_t
+ParseCpuList (const char* list,
+              cpu_set_t*  cpus)
+{
+    CPU_ZERO (cpus);
+    size_t cpus_number = 0;
+
+    const char* current = list;
+    while (*current != '\0' && *current != '\n')
+    {
+        char* range_end = NULL;
+        unsigned long first = strtoul (current, &range_end, 10);
+        if (range_end == current) break;
+
+        unsigned long last = first;
+        current = range_end;
+
+        if (*current == '-')
+        {
+            last = strtoul (current + 1, &range_end, 10);
+            current = range_end;
+        }
+
+        for (unsigned long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+        {
+            CPU_SET (cpu, cpus);
+            cpus_number++;
+        }
+
+        if (*current == ',') current++;
+    }
+
+    return cpus_number;
+}
+
+
+static quadratic_batch_status
+RunTasks (quadratic_equation_batch*         batch,
+          const quadratic_parallel_options* options,
+          bool                              initialize,
+          quadratic_cancel_token*           token,
+          size_t*                           solved_rows)
+{
+    pthread_once (&TOPOLOGY_ONCE, LoadTopology);
+
+    size_t threads = options->threads;
+    if (threads == 0)
+    {
+        long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (size_t) cpus : 1;
+    }
+
+    const size_t granularity = options->huge_pages ? PARALLEL_HUGE_PAGE_ROWS :
+                                                     PARALLEL_PAGE_ROWS;
+    const size_t chunk_rows =
+        AlignUp ((batch->size + threads - 1) / threads, granularity);
+    threads = (batch->size + chunk_rows - 1) / chunk_rows;
+
+    parallel_task* tasks      = calloc (threads, sizeof (parallel_task));
+    pthread_t*     thread_ids = calloc (threads, sizeof (pthread_t));
+    bool*          started    = calloc (threads, sizeof (bool));
+
+    if (tasks == NULL || thread_ids == NULL || started == NULL)
+    {
+        free (tasks);
+        free (thread_ids);
+        free (started);
+        return QUADRATIC_BATCH_ALLOC_ERROR;
+    }
+
+    const bool is_pinned = options->numa_aware && TOPOLOGY.nodes_number != 0;
+
+    atomic_size_t next_row          = 0;
+    atomic_size_t token_solved_rows = 0;
+
+    for (size_t i = 0; i < threads; i++)
+    {
+        tasks[i].batch      = batch;
+        tasks[i].first_row  = i * chunk_rows;
+        tasks[i].rows       = (batch->size - tasks[i].first_row < chunk_rows) ?
+                               batch->size - tasks[i].first_row : chunk_rows;
+        tasks[i].cpus       = is_pinned ?
+            &TOPOLOGY.node_cpus[i * TOPOLOGY.nodes_number / threads] : NULL;
+        tasks[i].options    = options;
+        tasks[i].initialize  = initialize;
+        tasks[i].token       = token;
+        tasks[i].next_row    = &next_row;
+        tasks[i].solved_rows = &token_solved_rows;
+        tasks[i].status      = QUADRATIC_BATCH_SUCCESS;
+    }
+
+    quadratic_batch_status status = QUADRATIC_BATCH_SUCCESS;
+
+    if (threads == 1 && !is_pinned) RunTask (&tasks[0]);
+
+    else
+    {
+        for (size_t i = 0; i < threads; i++)
+        {
+            started[i] = (pthread_create (&thread_ids[i], NULL,
+                                          RunTask, &tasks[i]) == 0);
+            if (!started[i]) RunTask (&tasks[i]);
+        }
+
+        for (size_t i = 0; i < threads; i++)
+            if (started[i]) pthread_join (thread_ids[i], NULL);
+    }
+
+    for (size_t i = 0; i < threads; i++)
+        if (status == QUADRATIC_BATCH_SUCCESS) status = tasks[i].status;
+
+    if (token != NULL)
+    {
+        const size_t rows = atomic_load (&token_solved_rows);
+        if (status == QUADRATIC_BATCH_SUCCESS && rows < batch->size)
+            status = QUADRATIC_BATCH_CANCELLED;
+        if (solved_rows != NULL) *solved_rows = rows;
+    }
+
+    free (tasks);
+    free (thread_ids);
+    free (started);
+
+    return status;
+}
+
+
+static void*
+RunTask (void* task_ptr)
+{
+    parallel_task* task = task_ptr;
+
+    if (task->cpus != NULL)
+        pthread_setaffinity_np (pthread_self (), sizeof (cpu_set_t), task->cpus);
+
+    if (task->token != NULL)
+    {
+        RunClaimedChunks (task);
+        return NULL;
+    }
+
+    const size_t first = task->first_row;
+    quadratic_equation_batch* batch = task->batch;
+
+    quadratic_equation_batch slice =
+    {
+        .size         = task->rows,
+        .a            = batch->a  + first,
+        .b            = batch->b  + first,
+        .c            = batch->c  + first,
+        .x1           = batch->x1 + first,
+        .x2           = batch->x2 + first,
+        .roots_number = batch->roots_number + first
+    };
+
+    if (!task->initialize)
+    {
+        task->status = SolveQuadraticBatch (&slice, &task->options->solve);
+        return NULL;
+    }
+
+    memset (slice.a, 0, slice.size * sizeof (double));
+    memset (slice.b, 0, slice.size * sizeof (double));
+    memset (slice.c, 0, slice.size * sizeof (double));
+
+    for (size_t i = 0; i < slice.size; i++)
+    {
+        slice.x1[i] = NAN;
+        slice.x2[i] = NAN;
+        slice.roots_number[i] = QUADRATIC_EQUATION_NOT_SOLVED;
+    }
+
+    return NULL;
+}
+
+
+static void
+RunClaimedChunks (parallel_task* task)
+{
+    quadratic_equation_batch* batch = task->batch;
+
+    // One cursor for all nodes ignores first-touch placement,
+    // but only a global claim order keeps the solved rows a prefix
+    while (task->status == QUADRATIC_BATCH_SUCCESS &&
+           !CancelTokenIsCancelled (task->token))
+    {
+        const size_t first_row =
+            atomic_fetch_add (task->next_row, QUADRATIC_BATCH_CANCEL_CHUNK_ROWS);
+        if (first_row >= batch->size) break;
+
+        size_t rows = batch->size - first_row;
+        if (rows > QUADRATIC_BATCH_CANCEL_CHUNK_ROWS)
+            rows = QUADRATIC_BATCH_CANCEL_CHUNK_ROWS;
+
+        quadratic_equation_batch chunk = {0};
+        BatchSlice (batch, first_row, rows, &chunk);
+
+        task->status = SolveQuadraticBatch (&chunk, &task->options->solve);
+        if (task->status == QUADRATIC_BATCH_SUCCESS)
+            atomic_fetch_add (task->solved_rows, rows);
+    }
+}
+
+
+static inline size_t
+AlignUp (size_t size,
+         size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,478 @@
+/**
+ * @file quadratic_equation_runtime.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Shared solver runtime implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "quadratic_equation_runtime.h"
+#include "monotonic_clock.h"
+
+
+
+#include <pthread.h>
+#include <unistd.h>
+
+
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/// @brief Default number of tenants
+static const size_t RUNTIME_DEFAULT_TENANTS_NUMBER = 64;
+
+/// @brief Default number of interactive slices in a row while bulk waits
+static const size_t RUNTIME_DEFAULT_INTERACTIVE_BURST = 8;
+
+/// @brief Wait of the first histogram bucket bound, seconds
+static const double RUNTIME_WAIT_BUCKET_UNIT = 1e-6;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static structs and types
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Jobs of one tenant in one priority class
+ */
+typedef
+struct runtime_queue
+{
+    quadratic_runtime_job* head;    ///< First job in the queue
+    quadratic_runtime_job* tail;    ///< Last  job in the queue
+}
+runtime_queue;
+
+
+/**
+ * @brief Solver runtime
+ */
+struct quadratic_runtime
+{
+    quadratic_runtime_options options;      ///< Runtime options
+    pthread_mutex_t           lock;         ///< Guard of the queues, jobs and metrics
+    pthread_cond_t            has_work;     ///< Some queue is not empty or runtime stops
+    pthread_cond_t            has_done;     ///< Some job is done
+    runtime_queue*            queues;       ///< Queues by priority, then by tenant
+    size_t                    cursors[QUADRATIC_PRIORITY_COUNT];    ///< Next tenants
+    size_t                    interactive_streak;   ///< Interactive slices in a row
+    quadratic_runtime_metrics metrics;      ///< Current metrics
+    bool                      is_stopping;  ///< Destructor is called
+    size_t                    threads;      ///< Number of started workers
+    pthread_t*                thread_ids;   ///< Workers
+};
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Worker thread routine
+ *
+ * @param runtime_ptr Pointer to the runtime
+ *
+ * @retval NULL
+ */
+static void*
+RunWorker (void* runtime_ptr);
+
+
+/**
+ * @brief Takes the next slice to solve
+ *
+ * @param runtime   Pointer to the locked runtime
+ * @param first_row Pointer to the first row of the slice in the job batch
+ * @param rows      Pointer to the rows number of the slice
+ *
+ * @retval Job of the slice
+ * @retval NULL if all queues are empty
+ */
+static quadratic_runtime_job*
+TakeSlice (quadratic_runtime* runtime,
+           size_t*            first_row,
+           size_t*            rows);
+
+
+/**
+ * @brief Adds the wait of the job to the metrics of its class
+ *
+ * @param metrics Pointer to the class metrics
+ * @param wait    Wait from submit to the first slice, seconds
+ */
+static void
+RecordWait (quadratic_runtime_class_metrics* metrics,
+            double                           wait);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Solver runtime interface implementation
+//------------------------------------------------------------------------------
+
+void
+RuntimeOptionsInit (quadratic_runtime_options* options)
+{
+    if (options == NULL) return;
+
+    options->threads           = 0;
+    options->tenants_number    = RUNTIME_DEFAULT_TENANTS_NUMBER;
+    options->slice_rows        = QUADRATIC_BATCH_CANCEL_CHUNK_ROWS;
+    options->interactive_burst = RUNTIME_DEFAULT_INTERACTIVE_BURST;
+
+    BatchOptionsInit (&options->solve);
+}
+
+
+quadratic_runtime*
+RuntimeConstructor (const quadratic_runtime_options* options)
+{
+    quadratic_runtime* runtime = calloc (1, sizeof (quadratic_runtime));
+    if (runtime == NULL) return NULL;
+
+    if (options != NULL) runtime->options = *options;
+    else RuntimeOptionsInit (&runtime->options);
+
+    if (runtime->options.tenants_number == 0) runtime->options.tenants_number = 1;
+    if (runtime->options.slice_rows     == 0)
+        runtime->options.slice_rows = QUADRATIC_BATCH_CANCEL_CHUNK_ROWS;
+
+    size_t threads = runtime->options.threads;
+    if (threads == 0)
+    {
+        long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (size_t) cpus : 1;
+    }
+
+    pthread_mutex_init (&runtime->lock,     NULL);
+    pthread_cond_init  (&runtime->has_work, NULL);
+    pthread_cond_init  (&runtime->has_done, NULL);
+
+    runtime->queues = calloc (QUADRATIC_PRIORITY_COUNT *
+                              runtime->options.tenants_number,
+                              sizeof (runtime_queue));
+    runtime->thread_ids = calloc (threads, sizeof (pthread_t));
+    if (runtime->queues == NULL || runtime->thread_ids == NULL)
+        return RuntimeDestructor (runtime);
+
+    for (size_t i = 0; i < threads; i++)
+    {
+        if (pthread_create (&runtime->thread_ids[i], NULL,
+                            RunWorker, runtime) != 0)
+            return RuntimeDestructor (runtime);
+
+        runtime->threads++;
+    }
+
+    return runtime;
+}
+
+
+quadratic_runtime*
+RuntimeDestructor (quadratic_runtime* runtime)
+{
+    if (runtime == NULL) return NULL;
+
+    pthread_mutex_lock (&runtime->lock);
+    runtime->is_stopping = true;
+    pthread_cond_broadcast (&runtime->has_work);
+    pthread_mutex_unlock (&runtime->lock);
+
+    for (size_t i = 0; i < runtime->threads; i++)
+        pthread_join (runtime->thread_ids[i], NULL);
+
+    pthread_mutex_destroy (&runtime->lock);
+    pthread_cond_destroy  (&runtime->has_work);
+    pthread_cond_destroy  (&runtime->has_done);
+
+    free (runtime->queues);
+    free (runtime->thread_ids);
+
+    free (runtime);
+    return NULL;
+}
+
+
+quadratic_batch_status
+RuntimeSubmit (quadratic_runtime*         runtime,
+               quadratic_runtime_job*     job,
+               quadratic_equation_batch*  batch,
+               size_t                     tenant,
+               quadratic_priority         priority,
+               quadratic_runtime_callback callback,
+               void*                      user_data)
+{
+    if (runtime == NULL || job == NULL || batch == NULL ||
+        tenant >= runtime->options.tenants_number ||
+        (size_t) priority >= QUADRATIC_PRIORITY_COUNT)
+        return QUADRATIC_BATCH_BAD_ARGS;
+
+    job->batch          = batch;
+    job->tenant         = tenant;
+    job->priority       = priority;
+    job->callback       = callback;
+    job->user_data      = user_data;
+    job->status         = QUADRATIC_BATCH_SUCCESS;
+    job->done           = false;
+    job->next_row       = 0;
+    job->running_slices = 0;
+    job->submit_time    = MonotonicSeconds ();
+    job->next           = NULL;
+
+    pthread_mutex_lock (&runtime->lock);
+
+    runtime_queue* queue =
+        &runtime->queues[priority * runtime->options.tenants_number + tenant];
+
+    if (queue->tail == NULL) queue->head       = job;
+    else                     queue->tail->next = job;
+    queue->tail = job;
+
+    quadratic_runtime_class_metrics* metrics =
+        &runtime->metrics.classes[priority];
+    metrics->queued_jobs++;
+    metrics->queued_rows += batch->size;
+    metrics->submitted_jobs++;
+
+    pthread_cond_broadcast (&runtime->has_work);
+    pthread_mutex_unlock (&runtime->lock);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+bool
+RuntimePoll (quadratic_runtime*     runtime,
+             quadratic_runtime_job* job)
+{
+    if (runtime == NULL || job == NULL) return false;
+
+    pthread_mutex_lock (&runtime->lock);
+    const bool is_done = job->done;
+    pthread_mutex_unlock (&runtime->lock);
+
+    return is_done;
+}
+
+
+quadratic_batch_status
+RuntimeWait (quadratic_runtime*     runtime,
+             quadratic_runtime_job* job)
+{
+    if (runtime == NULL || job == NULL) return QUADRATIC_BATCH_BAD_ARGS;
+
+    pthread_mutex_lock (&runtime->lock);
+
+    while (!job->done)
+        pthread_cond_wait (&runtime->has_done, &runtime->lock);
+
+    const quadratic_batch_status status = job->status;
+    pthread_mutex_unlock (&runtime->lock);
+
+    return status;
+}
+
+
+void
+RuntimeGetMetrics (quadratic_runtime*         runtime,
+                   quadratic_runtime_metrics* metrics)
+{
+    if (runtime == NULL || metrics == NULL) return;
+
+    pthread_mutex_lock (&runtime->lock);
+    *metrics = runtime->metrics;
+    pthread_mutex_unlock (&runtime->lock);
+}
+
+
+double
+RuntimeWaitPercentile (const quadratic_runtime_class_metrics* metrics,
+                       double                                 fraction)
+{
+    if (metrics == NULL) return 0;
+
+    size_t waits_number = 0;
+    for (size_t i = 0; i < QUADRATIC_RUNTIME_WAIT_BUCKETS; i++)
+        waits_number += metrics->wait_histogram[i];
+
+    if (waits_number == 0) return 0;
+
+    const double target = fraction * (double) waits_number;
+    double bound  = RUNTIME_WAIT_BUCKET_UNIT;
+    size_t counted = 0;
+
+    for (size_t i = 0; i < QUADRATIC_RUNTIME_WAIT_BUCKETS; i++, bound *= 2)
+    {
+        counted += metrics->wait_histogram[i];
+        if ((double) counted >= target) return bound;
+    }
+
+    return metrics->wait_seconds_max;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static void*
+RunWorker (void* runtime_ptr)
+{
+    quadratic_runtime* runtime = runtime_ptr;
+
+    pthread_mutex_lock (&runtime->lock);
+
+    while (true)
+    {
+        size_t first_row = 0;
+        size_t rows      = 0;
+        quadratic_runtime_job* job = TakeSlice (runtime, &first_row, &rows);
+
+        if (job == NULL)
+        {
+            if (runtime->is_stopping) break;
+
+            pthread_cond_wait (&runtime->has_work, &runtime->lock);
+            continue;
+        }
+
+        pthread_mutex_unlock (&runtime->lock);
+
+        quadratic_equation_batch slice = {0};
+        BatchSlice (job->batch, first_row, rows, &slice);
+
+        const quadratic_batch_status status =
+            SolveQuadraticBatch (&slice, &runtime->options.solve);
+
+        pthread_mutex_lock (&runtime->lock);
+
+        if (status != QUADRATIC_BATCH_SUCCESS) job->status = status;
+        job->running_slices--;
+        runtime->metrics.classes[job->priority].solved_rows += rows;
+
+        if (job->running_slices != 0 || job->next_row != job->batch->size)
+            continue;
+
+        quadratic_runtime_callback callback  = job->callback;
+        void*                      user_data = job->user_data;
+
+        runtime->metrics.classes[job->priority].completed_jobs++;
+        job->done = true;
+        pthread_cond_broadcast (&runtime->has_done);
+
+        if (callback == NULL) continue;
+
+        // A waiter may free the job now, so the callback is the last access
+        pthread_mutex_unlock (&runtime->lock);
+        callback (job, user_data);
+        pthread_mutex_lock (&runtime->lock);
+    }
+
+    pthread_mutex_unlock (&runtime->lock);
+
+    return NULL;
+}
+
+
+static quadratic_runtime_job*
+TakeSlice (quadratic_runtime* runtime,
+           size_t*            first_row,
+           size_t*            rows)
+{
+    quadratic_runtime_metrics* metrics = &runtime->metrics;
+
+    const bool has_interactive =
+        metrics->classes[QUADRATIC_PRIORITY_INTERACTIVE].queued_jobs != 0;
+    const bool has_bulk =
+        metrics->classes[QUADRATIC_PRIORITY_BULK].queued_jobs != 0;
+
+    if (!has_interactive && !has_bulk) return NULL;
+
+    const bool is_bulk_due =
+        has_bulk && runtime->interactive_streak >=
+                    runtime->options.interactive_burst;
+
+    const quadratic_priority priority = (has_interactive && !is_bulk_due) ?
+                                        QUADRATIC_PRIORITY_INTERACTIVE :
+                                        QUADRATIC_PRIORITY_BULK;
+
+    runtime->interactive_streak =
+        (priority == QUADRATIC_PRIORITY_INTERACTIVE && has_bulk) ?
+        runtime->interactive_streak + 1 : 0;
+
+    const size_t   tenants_number = runtime->options.tenants_number;
+    runtime_queue* queues         = runtime->queues + priority * tenants_number;
+
+    size_t tenant = runtime->cursors[priority];
+    while (queues[tenant].head == NULL) tenant = (tenant + 1) % tenants_number;
+
+    runtime->cursors[priority] = (tenant + 1) % tenants_number;
+
+    runtime_queue*         queue = &queues[tenant];
+    quadratic_runtime_job* job   = queue->head;
+    quadratic_runtime_class_metrics* class_metrics = &metrics->classes[priority];
+
+    if (job->next_row == 0)
+        RecordWait (class_metrics, MonotonicSeconds () - job->submit_time);
+
+    *first_row = job->next_row;
+    *rows      = job->batch->size - job->next_row;
+    if (*rows > runtime->options.slice_rows) *rows = runtime->options.slice_rows;
+
+    job->next_row += *rows;
+    job->running_slices++;
+    class_metrics->queued_rows -= *rows;
+
+    if (job->next_row == job->batch->size)
+    {
+        queue->head = job->next;
+        if (queue->head == NULL) queue->tail = NULL;
+
+        class_metrics->queued_jobs--;
+    }
+
+    return job;
+}
+
+
+static void
+RecordWait (quadratic_runtime_class_metrics* metrics,
+            double                           wait)
+{
+    metrics->wait_seconds_total += wait;
+    if (wait > metrics->wait_seconds_max) metrics->wait_seconds_max = wait;
+
+    size_t bucket = 0;
+    for (double bound = RUNTIME_WAIT_BUCKET_UNIT;
+         wait >= bound && bucket + 1 < QUADRATIC_RUNTIME_WAIT_BUCKETS;
+         bound *= 2)
+        bucket++;
+
+    metrics->wait_histogram[bucket]++;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+/**
+ * @file quadratic_equation_special.c
+ *
+ * @author SeveraTheDuck
+ *
+ * @brief Specialized batch solvers implementation
+ *
+ * @date 2026-10-18
+ *
+ * @copyright GNU GPL v.3
+ */
+
+
+
+#include "quadratic_equation_special.h"
+
+
+
+//------------------------------------------------------------------------------
+// Static functions
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Checks that the batch and its columns are not NULL
+ *
+ * @param batch Pointer to the batch
+ *
+ * @retval true if the batch may be solved
+ */
+static bool
+IsBatchValid (const quadratic_equation_batch* batch);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Specialized batch solvers implementation
+//------------------------------------------------------------------------------
+
+quadratic_batch_status
+SolveMonicBatch (quadratic_equation_batch* batch)
+{
+    if (!IsBatchValid (batch)) return QUADRATIC_BATCH_BAD_ARGS;
+
+    for (size_t i = 0; i < batch->size; i++)
+        batch->roots_number[i] =
+            SolveMonicEquation (batch->b[i], batch->c[i],
+                                &batch->x1[i], &batch->x2[i]);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_batch_status
+SolvePureQuadraticBatch (quadratic_equation_batch* batch)
+{
+    if (!IsBatchValid (batch)) return QUADRATIC_BATCH_BAD_ARGS;
+
+    for (size_t i = 0; i < batch->size; i++)
+        batch->roots_number[i] =
+            SolvePureQuadraticEquation (batch->a[i], batch->c[i],
+                                        &batch->x1[i], &batch->x2[i]);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+
+quadratic_batch_status
+SolveNoFreeTermBatch (quadratic_equation_batch* batch)
+{
+    if (!IsBatchValid (batch)) return QUADRATIC_BATCH_BAD_ARGS;
+
+    for (size_t i = 0; i < batch->size; i++)
+        batch->roots_number[i] =
+            SolveNoFreeTermEquation (batch->a[i], batch->b[i],
+                                     &batch->x1[i], &batch->x2[i]);
+
+    return QUADRATIC_BATCH_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------
+// Static functions implementation
+//------------------------------------------------------------------------------
+
+static bool
+IsBatchValid (const quadratic_equation_batch* batch)
+{
+    if (batch == NULL) return false;
+    if (batch->size == 0) return true;
+
+    return batch->a  != NULL && batch->b  != NULL && batch->c != NULL &&
+           batch->x1 != NULL && batch->x2 != NULL &&
+           batch->roots_number != NULL;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -1,14 +1,140 @@
 #include "quadratic_equation.h"
+#include "quadratic_equation_check.h"
+#include "csv_ingest.h"
 #include "input_output.h"
+#include "monotonic_clock.h"
 
 
 
 #include <assert.h>
+#include <string.h>
 
 
 
-int main (void)
+/// @brief Rows in one differential check round
+static const size_t CHECK_ROUND_ROWS = 1 << 16;
+
+/// @brief Default number of differential check rounds
+static const unsigned long CHECK_DEFAULT_ROUNDS = 16;
+
+/// @brief Messages of the --csv mode
+static const char* const CSV_ERROR_MESSAGES[] =
+{
+    "",
+    "Bad arguments",
+    "Column is not found",
+    "Allocation error",
+    "Input or output error",
+    "Thread can not be started",
+    "Bad checkpoint or not seekable input or output"
+};
+
+_Static_assert (sizeof (CSV_ERROR_MESSAGES) /
+                sizeof (CSV_ERROR_MESSAGES[0]) == CSV_INGEST_STATUS_COUNT,
+                "every CSV status needs a message");
+
+/// @brief Messages of the --bench mode
+static const char* const BENCH_ERROR_MESSAGES[] =
 {
+    "",
+    "Bad arguments",
+    "Allocation error",
+    "Cancelled or deadline passed"
+};
+
+_Static_assert (sizeof (BENCH_ERROR_MESSAGES) /
+                sizeof (BENCH_ERROR_MESSAGES[0]) == QUADRATIC_BATCH_STATUS_COUNT,
+                "every batch status needs a message");
+
+/// @brief Default number of samples of the --latency mode
+static const size_t LATENCY_DEFAULT_SAMPLES = 1 << 20;
+
+/// @brief Maximum input size of the --fuzz mode
+#define FUZZ_MAX_INPUT_SIZE (1 << 20)
+
+
+
+/**
+ * @brief Runs differential check of the batch solvers
+ *
+ * @param argc Number of arguments after --check
+ * @param argv Arguments after --check: [rounds] [seed]
+ *
+ * @retval 0 if all variants agree with the reference, 1 otherwise
+ */
+static int
+RunCheck (int argc, char* argv[]);
+
+
+/**
+ * @brief Runs differential check of raw coefficients read from stdin
+ *
+ * @retval 0 if all variants agree with the reference
+ *
+ * @details Aborts on divergence, so AFL registers it as a crash
+ */
+static int
+RunFuzz (void);
+
+
+/**
+ * @brief Solves equations from delimited stdin (or file) to stdout (or file)
+ *
+ * @param argc Number of arguments after --csv
+ * @param argv Arguments after --csv:
+ * [--tsv] [--delimiter C] [--no-header] [--a COL] [--b COL] [--c COL]
+ * [--key COL] [--threads N] [--classify] [--polish] [--route] [--sort]
+ * [--fast] [--arrow] [--stats] [--input FILE] [--output FILE]
+ * [--checkpoint FILE] [--checkpoint-interval BYTES] [--resume]
+ *
+ * @retval 0 upon success, 1 otherwise
+ */
+static int
+RunCsv (int argc, char* argv[]);
+
+
+/**
+ * @brief Runs throughput benchmark of the batch solvers
+ *
+ * @param argc Number of arguments after --bench
+ * @param argv Arguments after --bench: [rows] [threads] [repeats]
+ *
+ * @retval 0 upon success, 1 otherwise
+ */
+static int
+RunBench (int argc, char* argv[]);
+
+
+/**
+ * @brief Runs latency benchmark of the single equation solvers
+ *
+ * @param argc Number of arguments after --latency
+ * @param argv Arguments after --latency: [samples] [seed]
+ *
+ * @retval 0 upon success, 1 otherwise
+ */
+static int
+RunLatency (int argc, char* argv[]);
+
+
+
+int main (int argc, char* argv[])
+{
+    if (argc > 1 && strcmp (argv[1], "--check") == 0)
+        return RunCheck (argc - 2, argv + 2);
+
+    if (argc > 1 && strcmp (argv[1], "--fuzz") == 0)
+        return RunFuzz ();
+
+    if (argc > 1 && strcmp (argv[1], "--csv") == 0)
+        return RunCsv (argc - 2, argv + 2);
+
+    if (argc > 1 && strcmp (argv[1], "--bench") == 0)
+        return RunBench (argc - 2, argv + 2);
+
+    if (argc > 1 && strcmp (argv[1], "--latency") == 0)
+        return RunLatency (argc - 2, argv + 2);
+
     quadratic_equation_coefs* coefs = ReadCoefs ();
     assert (coefs);
 
@@ -21,3 +147,238 @@ int main (void)
 
     return 0;
 }
+
+
+
+static int
+RunCheck (int argc, char* argv[])
+{
+    const unsigned long rounds =
+        (argc > 0) ? strtoul (argv[0], NULL, 10) : CHECK_DEFAULT_ROUNDS;
+    const uint64_t seed =
+        (argc > 1) ? strtoull (argv[1], NULL, 10) : 1;
+
+    quadratic_equation_batch* batch = BatchConstructor (CHECK_ROUND_ROWS);
+    if (batch == NULL) return 1;
+
+    quadratic_check_report report = {0};
+    quadratic_batch_status status = QUADRATIC_BATCH_SUCCESS;
+    size_t rows_checked = 0;
+
+    for (unsigned long round = 0; round < rounds; round++)
+    {
+        CheckFillBatch (batch, seed + round);
+
+        status = CheckBatchVariants (batch, &report);
+        if (status != QUADRATIC_BATCH_SUCCESS || report.diverged) break;
+
+        rows_checked += report.rows_checked;
+    }
+
+    batch = BatchDestructor (batch);
+    if (status != QUADRATIC_BATCH_SUCCESS) return 1;
+
+    report.rows_checked = rows_checked;
+    PrintCheckReport (&report);
+
+    return report.diverged ? 1 : 0;
+}
+
+
+static int
+RunFuzz (void)
+{
+    static uint8_t data[FUZZ_MAX_INPUT_SIZE];
+
+    const size_t size = fread (data, 1, sizeof (data), stdin);
+
+    quadratic_check_report report = {0};
+    if (CheckRawInput (data, size, &report) != QUADRATIC_BATCH_SUCCESS)
+        return 1;
+
+    if (report.diverged)
+    {
+        PrintCheckReport (&report);
+        abort ();
+    }
+
+    return 0;
+}
+
+
+static int
+RunCsv (int argc, char* argv[])
+{
+    csv_ingest_options options = {0};
+    CsvIngestOptionsInit (&options);
+
+    bool print_stats = false;
+    const char* input_path  = NULL;
+    const char* output_path = NULL;
+
+    for (int i = 0; i < argc; i++)
+    {
+        if      (strcmp (argv[i], "--tsv")       == 0) options.delimiter  = '\t';
+        else if (strcmp (argv[i], "--no-header") == 0) options.has_header = false;
+        else if (strcmp (argv[i], "--classify")  == 0)
+            options.solve.classify_first = true;
+        else if (strcmp (argv[i], "--polish")    == 0)
+            options.solve.polish_roots   = true;
+        else if (strcmp (argv[i], "--route")     == 0)
+            options.solve.route_patterns = true;
+        else if (strcmp (argv[i], "--sort")      == 0)
+            options.solve.sort_roots     = true;
+        else if (strcmp (argv[i], "--fast")      == 0)
+            options.solve.fast_division  = true;
+        else if (strcmp (argv[i], "--stats")     == 0)
+            print_stats                  = true;
+        else if (strcmp (argv[i], "--arrow")     == 0)
+            options.arrow_output         = true;
+        else if (strcmp (argv[i], "--resume")    == 0)
+            options.resume               = true;
+
+        else if (i + 1 < argc && strcmp (argv[i], "--delimiter") == 0)
+            options.delimiter  = argv[++i][0];
+        else if (i + 1 < argc && strcmp (argv[i], "--a")   == 0)
+            options.a_column   = argv[++i];
+        else if (i + 1 < argc && strcmp (argv[i], "--b")   == 0)
+            options.b_column   = argv[++i];
+        else if (i + 1 < argc && strcmp (argv[i], "--c")   == 0)
+            options.c_column   = argv[++i];
+        else if (i + 1 < argc && strcmp (argv[i], "--key") == 0)
+            options.key_column = argv[++i];
+        else if (i + 1 < argc && strcmp (argv[i], "--threads") == 0)
+            options.threads    = strtoul (argv[++i], NULL, 10);
+        else if (i + 1 < argc && strcmp (argv[i], "--input")   == 0)
+            input_path         = argv[++i];
+        else if (i + 1 < argc && strcmp (argv[i], "--output")  == 0)
+            output_path        = argv[++i];
+        else if (i + 1 < argc && strcmp (argv[i], "--checkpoint") == 0)
+            options.checkpoint_path = argv[++i];
+        else if (i + 1 < argc && strcmp (argv[i], "--checkpoint-interval") == 0)
+            options.checkpoint_interval = strtoul (argv[++i], NULL, 10);
+
+        else
+        {
+            fprintf (stderr, "%s: %s\n",
+                     CSV_ERROR_MESSAGES[CSV_INGEST_BAD_ARGS], argv[i]);
+            return 1;
+        }
+    }
+
+    // Checked before the output is opened, so it is not truncated in vain
+    if (options.resume && options.checkpoint_path == NULL)
+    {
+        fprintf (stderr, "%s: --resume without --checkpoint\n",
+                 CSV_ERROR_MESSAGES[CSV_INGEST_BAD_ARGS]);
+        return 1;
+    }
+
+    FILE* input  = (input_path != NULL) ? fopen (input_path, "rb") : stdin;
+    FILE* output = stdout;
+
+    if (output_path != NULL)
+    {
+        // Resumed output keeps its committed part, so it is not truncated here
+        output = options.resume ? fopen (output_path, "r+b") : NULL;
+        if (output == NULL) output = fopen (output_path, "wb");
+    }
+
+    if (input == NULL || output == NULL)
+    {
+        fprintf (stderr, "%s: %s\n", CSV_ERROR_MESSAGES[CSV_INGEST_IO_ERROR],
+                 (input == NULL) ? input_path : output_path);
+        if (input  != NULL && input  != stdin)  fclose (input);
+        if (output != NULL && output != stdout) fclose (output);
+        return 1;
+    }
+
+    perf_counters counters = {0};
+    if (print_stats)
+    {
+        PerfCountersOpen  (&counters);
+        PerfCountersStart (&counters);
+    }
+
+    size_t rows_number = 0;
+    const double start = MonotonicSeconds ();
+
+    csv_ingest_status status =
+        CsvSolveStream (input, output, &options, &rows_number);
+
+    if (input != stdin) fclose (input);
+    if (output != stdout && fclose (output) != 0 &&
+        status == CSV_INGEST_SUCCESS)
+        status = CSV_INGEST_IO_ERROR;
+
+    perf_counters_values values = {0};
+    if (print_stats)
+    {
+        PerfCountersStop  (&counters, &values);
+        PerfCountersClose (&counters);
+    }
+
+    if (print_stats && status == CSV_INGEST_SUCCESS)
+    {
+        quadratic_bench_result result = {.name    = "csv",
+                                         .seconds = MonotonicSeconds () - start};
+        if (result.seconds > 0)
+            result.rows_per_second = (double) rows_number / result.seconds;
+
+        BenchSetCounters (&result, &values, rows_number);
+
+        fprintf (stderr, "Equations: %zu\n", rows_number);
+        PrintBenchResult (stderr, &result);
+    }
+
+    if (status == CSV_INGEST_SUCCESS) return 0;
+
+    fprintf (stderr, "%s\n", CSV_ERROR_MESSAGES[status]);
+    return 1;
+}
+
+
+static int
+RunBench (int argc, char* argv[])
+{
+    quadratic_bench_options options = {0};
+    BenchOptionsInit (&options);
+
+    if (argc > 0) options.rows    = strtoul (argv[0], NULL, 10);
+    if (argc > 1) options.threads = strtoul (argv[1], NULL, 10);
+    if (argc > 2) options.repeats = strtoul (argv[2], NULL, 10);
+
+    quadratic_bench_report report = {0};
+    quadratic_batch_status status = BenchRun (&options, &report);
+    if (status == QUADRATIC_BATCH_SUCCESS)
+    {
+        PrintBenchReport (&report);
+        return 0;
+    }
+
+    fprintf (stderr, "%s\n", BENCH_ERROR_MESSAGES[status]);
+    return 1;
+}
+
+
+static int
+RunLatency (int argc, char* argv[])
+{
+    quadratic_bench_options options = {0};
+    BenchOptionsInit (&options);
+    options.rows = LATENCY_DEFAULT_SAMPLES;
+
+    if (argc > 0) options.rows = strtoul (argv[0], NULL, 10);
+    if (argc > 1) options.seed = strtoull (argv[1], NULL, 10);
+
+    quadratic_latency_report report = {0};
+    quadratic_batch_status status = BenchLatencyRun (&options, &report);
+    if (status == QUADRATIC_BATCH_SUCCESS)
+    {
+        PrintLatencyReport (&report);
+        return 0;
+    }
+
+    fprintf (stderr, "%s\n", BENCH_ERROR_MESSAGES[status]);
+    return 1;
+}